@@ -20,7 +20,9 @@
 #pragma once
 #include "GenericID.hpp"
 #include "Index.hpp"
+#include "Stencil.hpp"
 #include <CL/sycl.hpp>
+#include <stdexcept>
 
 namespace stencil {
 /**
@@ -73,6 +75,8 @@ template <typename T, uindex_t stencil_radius, typename TransFunc> class Abstrac
      * retrieved with \ref AbstractExecutor.copy_output.
      *
      * \param n_generations The number of generations to calculate.
+     * \throws std::invalid_argument Thrown if the generation index is not a multiple of the
+     * transition function's \ref stage_period.
      */
     virtual void run(uindex_t n_generations) = 0;
 
@@ -138,6 +142,25 @@ template <typename T, uindex_t stencil_radius, typename TransFunc> class Abstrac
      */
     void inc_i_generation(index_t delta) { this->i_generation += delta; }
 
+  protected:
+    /**
+     * \brief Check that a pass may start with the given generation index.
+     *
+     * Since every pass starts with pipeline stage 0, the generation index has to be a multiple of
+     * the \ref stage_period of the transition function. Otherwise, the stages would apply the
+     * data paths of the transition function out of order.
+     *
+     * \param i_generation The generation index of the pass input.
+     * \throws std::invalid_argument Thrown if the generation index is not a multiple of the stage
+     * period.
+     */
+    static void check_pass_start(uindex_t i_generation) {
+        if (i_generation % stage_period<TransFunc>::value != 0) {
+            throw std::invalid_argument("A pass has to start with a generation index that is a "
+                                        "multiple of the transition function's stage period");
+        }
+    }
+
   private:
     T halo_value;
     TransFunc trans_func;
@@ -0,0 +1,187 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "MonotileExecutor.hpp"
+#include "SingleQueueExecutor.hpp"
+#include "StencilExecutor.hpp"
+#include <utility>
+
+namespace stencil {
+/**
+ * \brief An executor that chooses between \ref monotile and \ref tiling by the grid range.
+ *
+ * The executor contains a \ref MonotileExecutor and a \ref StencilExecutor with the same pipeline
+ * length and tile range. If the grid fits into a single tile, it is processed by the monotile
+ * executor, which has no halo overhead and simpler IO kernels. Otherwise, it is processed by the
+ * tiling executor. The choice is made whenever a new grid is set with \ref AutoExecutor.set_input,
+ * and the generation index, the transition function, the halo value, the queue and the runtime
+ * sample are shared among both executors. The device code of both architectures is synthesized.
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam TransFunc The type of the transition function.
+ * \tparam pipeline_length The number of hardware execution stages per kernel. Must be at least 1.
+ * Defaults to 1.
+ * \tparam tile_width The number of columns in a tile. Defaults to 1024.
+ * \tparam tile_height The number of rows in a tile. Defaults to 1024.
+ * \tparam burst_size The number of bytes to load/store in one burst. Defaults to 1024.
+ */
+template <typename T, uindex_t stencil_radius, typename TransFunc, uindex_t pipeline_length = 1,
+          uindex_t tile_width = 1024, uindex_t tile_height = 1024, uindex_t burst_size = 1024>
+class AutoExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc> {
+  public:
+    /**
+     * \brief Shorthand for the parent class.
+     */
+    using Parent = SingleQueueExecutor<T, stencil_radius, TransFunc>;
+
+    /**
+     * \brief The type of the executor that is used if the grid fits into a tile.
+     */
+    using MonotileExecutorImpl = MonotileExecutor<T, stencil_radius, TransFunc, pipeline_length,
+                                                  tile_width, tile_height, burst_size>;
+
+    /**
+     * \brief The type of the executor that is used if the grid does not fit into a tile.
+     */
+    using TilingExecutorImpl = StencilExecutor<T, stencil_radius, TransFunc, pipeline_length,
+                                               tile_width, tile_height, burst_size>;
+
+    /**
+     * \brief Create a new executor.
+     *
+     * \param halo_value The value of cells in the grid halo.
+     * \param trans_func An instance of the transition function type.
+     */
+    AutoExecutor(T halo_value, TransFunc trans_func)
+        : Parent(halo_value, trans_func), monotile_executor(halo_value, trans_func),
+          tiling_executor(halo_value, trans_func), use_monotile(false) {}
+
+    /**
+     * \brief Check whether a grid range fits into a single tile.
+     */
+    static bool fits_into_tile(UID grid_range) {
+        return grid_range.c <= tile_width && grid_range.r <= tile_height;
+    }
+
+    /**
+     * \brief Set the internal state of the grid and choose the executor for it.
+     *
+     * The grid of the previously used executor is released. The generation index is not reset.
+     *
+     * \param input_buffer The source buffer of the new grid state.
+     */
+    void set_input(cl::sycl::buffer<T, 2> input_buffer) override {
+        cl::sycl::buffer<T, 2> empty_buffer(cl::sycl::range<2>(0, 0));
+        use_monotile = fits_into_tile(input_buffer.get_range());
+        if (use_monotile) {
+            monotile_executor.set_input(input_buffer);
+            tiling_executor.set_input(empty_buffer);
+        } else {
+            tiling_executor.set_input(input_buffer);
+            monotile_executor.set_input(empty_buffer);
+        }
+    }
+
+    void copy_output(cl::sycl::buffer<T, 2> output_buffer) override {
+        if (use_monotile) {
+            monotile_executor.copy_output(output_buffer);
+        } else {
+            tiling_executor.copy_output(output_buffer);
+        }
+    }
+
+    /**
+     * \brief Copy a strided region of the grid to a buffer.
+     *
+     * See \ref StencilExecutor.copy_output for details.
+     */
+    void copy_output(cl::sycl::buffer<T, 2> output_buffer, UID region_offset, UID region_range,
+                     UID stride = UID(1, 1)) {
+        sync_state(get_active_executor());
+        if (use_monotile) {
+            monotile_executor.copy_output(output_buffer, region_offset, region_range, stride);
+        } else {
+            tiling_executor.copy_output(output_buffer, region_offset, region_range, stride);
+        }
+    }
+
+    UID get_grid_range() const override {
+        if (use_monotile) {
+            return monotile_executor.get_grid_range();
+        } else {
+            return tiling_executor.get_grid_range();
+        }
+    }
+
+    void run(uindex_t n_generations) override {
+        Parent &executor = get_active_executor();
+        sync_state(executor);
+        std::swap(executor.get_runtime_sample(), this->get_runtime_sample());
+        executor.run(n_generations);
+        std::swap(executor.get_runtime_sample(), this->get_runtime_sample());
+        this->set_i_generation(executor.get_i_generation());
+    }
+
+    /**
+     * \brief Compute generations until a reduction of the last pass satisfies a predicate.
+     *
+     * See \ref StencilExecutor.run_until for details.
+     */
+    template <typename Reduction, typename Predicate>
+    typename Reduction::Value run_until(Reduction reduction, Predicate predicate,
+                                        uindex_t max_generations) {
+        Parent &executor = get_active_executor();
+        sync_state(executor);
+        std::swap(executor.get_runtime_sample(), this->get_runtime_sample());
+        typename Reduction::Value value =
+            use_monotile ? monotile_executor.run_until(reduction, predicate, max_generations)
+                         : tiling_executor.run_until(reduction, predicate, max_generations);
+        std::swap(executor.get_runtime_sample(), this->get_runtime_sample());
+        this->set_i_generation(executor.get_i_generation());
+        return value;
+    }
+
+    /**
+     * \brief Check whether the current grid is processed by the monotile executor.
+     */
+    bool is_monotile_active() const { return use_monotile; }
+
+  private:
+    Parent &get_active_executor() {
+        if (use_monotile) {
+            return monotile_executor;
+        } else {
+            return tiling_executor;
+        }
+    }
+
+    void sync_state(Parent &executor) {
+        executor.set_halo_value(this->get_halo_value());
+        executor.set_trans_func(this->get_trans_func());
+        executor.set_i_generation(this->get_i_generation());
+        executor.set_queue(this->get_queue());
+    }
+
+    MonotileExecutorImpl monotile_executor;
+    TilingExecutorImpl tiling_executor;
+    bool use_monotile;
+};
+} // namespace stencil
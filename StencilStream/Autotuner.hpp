@@ -0,0 +1,301 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "MonotileExecutor.hpp"
+#include "PerformanceModel.hpp"
+#include "StencilExecutor.hpp"
+#include <algorithm>
+#include <chrono>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace stencil {
+/**
+ * \brief The evaluation of a candidate configuration by the \ref Autotuner.
+ */
+struct TuningResult {
+    /**
+     * \brief The number of hardware execution stages of the configuration.
+     */
+    uindex_t pipeline_length;
+
+    /**
+     * \brief The number of columns in a tile of the configuration.
+     */
+    uindex_t tile_width;
+
+    /**
+     * \brief The number of rows in a tile of the configuration.
+     */
+    uindex_t tile_height;
+
+    /**
+     * \brief Whether the configuration uses the \ref MonotileExecutor.
+     */
+    bool monotile;
+
+    /**
+     * \brief The predicted or measured runtime for the requested number of generations, in
+     * seconds.
+     */
+    double runtime;
+};
+
+/**
+ * \brief A candidate configuration for the \ref Autotuner.
+ *
+ * \tparam pipeline_length The number of hardware execution stages.
+ * \tparam tile_width The number of columns in a tile.
+ * \tparam tile_height The number of rows in a tile.
+ * \tparam monotile Use the \ref MonotileExecutor instead of the \ref StencilExecutor. Monotile
+ * configurations are only considered if the grid fits into the tile.
+ */
+template <uindex_t pipeline_length, uindex_t tile_width, uindex_t tile_height,
+          bool monotile = false>
+struct TuningConfiguration {
+    /**
+     * \brief The executor type of the configuration.
+     */
+    template <typename T, uindex_t stencil_radius, typename TransFunc>
+    using Executor = typename std::conditional<
+        monotile,
+        MonotileExecutor<T, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>,
+        StencilExecutor<T, stencil_radius, TransFunc, pipeline_length, tile_width,
+                        tile_height>>::type;
+
+    /**
+     * \brief The performance model of the configuration.
+     */
+    template <typename T, uindex_t stencil_radius>
+    using PerformanceModel = typename std::conditional<
+        monotile,
+        MonotilePerformanceModel<T, stencil_radius, pipeline_length, tile_width, tile_height>,
+        TilingPerformanceModel<T, stencil_radius, pipeline_length, tile_width,
+                               tile_height>>::type;
+
+    /**
+     * \brief Return the pipeline length of the configuration.
+     */
+    static constexpr uindex_t get_pipeline_length() { return pipeline_length; }
+
+    /**
+     * \brief Create the result of an evaluation of this configuration.
+     *
+     * \param runtime The predicted or measured runtime of the configuration, in seconds.
+     */
+    static TuningResult make_result(double runtime) {
+        return TuningResult{pipeline_length, tile_width, tile_height, monotile, runtime};
+    }
+
+    /**
+     * \brief Check whether the configuration can process a grid of the given range.
+     */
+    static bool supports_grid(UID grid_range) {
+        return !monotile || (grid_range.c <= tile_width && grid_range.r <= tile_height);
+    }
+};
+
+/**
+ * \brief Shorthand for a candidate configuration of the \ref StencilExecutor.
+ */
+template <uindex_t pipeline_length, uindex_t tile_width, uindex_t tile_height>
+using TilingConfiguration = TuningConfiguration<pipeline_length, tile_width, tile_height, false>;
+
+/**
+ * \brief Shorthand for a candidate configuration of the \ref MonotileExecutor.
+ */
+template <uindex_t pipeline_length, uindex_t tile_width, uindex_t tile_height>
+using MonotileConfiguration = TuningConfiguration<pipeline_length, tile_width, tile_height, true>;
+
+/**
+ * \brief Select the best configuration for a grid from a set of pre-instantiated configurations.
+ *
+ * Tile range and pipeline length are template parameters of the executors, so they can not be
+ * chosen at runtime. Instead, the application instantiates the autotuner with a list of \ref
+ * TuningConfiguration candidates and evaluates them for a representative grid. This can either
+ * be done by measuring the runtime of every candidate on a real device or, for emulator and host
+ * runs where measurements are not representative, by predicting the runtime with the
+ * performance model of every candidate. The best configuration can then be written as a header
+ * that the final build of the application includes.
+ *
+ * Example:
+ * ```
+ * using Tuner = Autotuner<float, 1, Kernel, TilingConfiguration<16, 512, 512>,
+ *                         TilingConfiguration<32, 1024, 1024>>;
+ * std::vector<TuningResult> results = Tuner::predict(UID(4096, 4096), 1000, 300e6);
+ * Tuner::write_header(std::cout, Tuner::get_best(results));
+ * ```
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam TransFunc The type of the transition function.
+ * \tparam Configurations The candidate configurations, instantiations of \ref
+ * TuningConfiguration.
+ */
+template <typename T, uindex_t stencil_radius, typename TransFunc, typename... Configurations>
+class Autotuner {
+  public:
+    static_assert(sizeof...(Configurations) > 0);
+
+    /**
+     * \brief Predict the runtime of all candidates that support the grid range.
+     *
+     * The prediction uses the performance models of the executors and assumes that every
+     * candidate runs at the same clock frequency.
+     *
+     * \param grid_range The range of the representative grid.
+     * \param n_generations The number of generations to compute.
+     * \param clock_frequency The expected clock frequency of the execution kernels, in Hz.
+     * \return The results of all supported candidates, sorted by ascending runtime.
+     */
+    static std::vector<TuningResult> predict(UID grid_range, uindex_t n_generations,
+                                             double clock_frequency) {
+        std::vector<TuningResult> results;
+        (predict_configuration<Configurations>(results, grid_range, n_generations,
+                                               clock_frequency),
+         ...);
+        sort_results(results);
+        return results;
+    }
+
+    /**
+     * \brief Measure the runtime of all candidates that support the range of the input grid.
+     *
+     * Every candidate is first run for one pass to exclude device initialization and is then
+     * timed for the requested number of generations.
+     *
+     * \param queue The queue to execute the candidates with.
+     * \param input_buffer The representative grid.
+     * \param n_generations The number of generations to compute.
+     * \param halo_value The value of cells in the grid halo.
+     * \param trans_func An instance of the transition function.
+     * \return The results of all supported candidates, sorted by ascending runtime.
+     */
+    static std::vector<TuningResult> measure(cl::sycl::queue queue,
+                                             cl::sycl::buffer<T, 2> input_buffer,
+                                             uindex_t n_generations, T halo_value,
+                                             TransFunc trans_func) {
+        std::vector<TuningResult> results;
+        (measure_configuration<Configurations>(results, queue, input_buffer, n_generations,
+                                               halo_value, trans_func),
+         ...);
+        sort_results(results);
+        return results;
+    }
+
+    /**
+     * \brief Return the result with the lowest runtime.
+     *
+     * \throws std::invalid_argument Thrown if the list of results is empty, which happens if no
+     * candidate supports the grid range.
+     */
+    static TuningResult get_best(std::vector<TuningResult> const &results) {
+        if (results.empty()) {
+            throw std::invalid_argument("No candidate configuration supports the grid");
+        }
+        return *std::min_element(results.begin(), results.end(),
+                                 [](TuningResult const &a, TuningResult const &b) {
+                                     return a.runtime < b.runtime;
+                                 });
+    }
+
+    /**
+     * \brief Write a configuration as a header that defines it as constants.
+     *
+     * The header defines `tuned_pipeline_length`, `tuned_tile_width`, `tuned_tile_height` and
+     * `tuned_monotile` in the `stencil` namespace.
+     *
+     * \param out The stream to write the header to.
+     * \param result The configuration to write.
+     */
+    static void write_header(std::ostream &out, TuningResult const &result) {
+        out << "// Generated by the StencilStream autotuner. Expected runtime: " << result.runtime
+            << " s\n";
+        out << "#pragma once\n";
+        out << "#include <StencilStream/Index.hpp>\n\n";
+        out << "namespace stencil {\n";
+        out << "constexpr uindex_t tuned_pipeline_length = " << result.pipeline_length << ";\n";
+        out << "constexpr uindex_t tuned_tile_width = " << result.tile_width << ";\n";
+        out << "constexpr uindex_t tuned_tile_height = " << result.tile_height << ";\n";
+        out << "constexpr bool tuned_monotile = " << (result.monotile ? "true" : "false")
+            << ";\n";
+        out << "} // namespace stencil\n";
+    }
+
+  private:
+    template <typename Configuration>
+    using ExecutorImpl = typename Configuration::template Executor<T, stencil_radius, TransFunc>;
+
+    template <typename Configuration>
+    static void predict_configuration(std::vector<TuningResult> &results, UID grid_range,
+                                      uindex_t n_generations, double clock_frequency) {
+        using Model = typename Configuration::template PerformanceModel<T, stencil_radius>;
+        if (!Configuration::supports_grid(grid_range)) {
+            return;
+        }
+
+        constexpr uindex_t pipeline_length = Configuration::get_pipeline_length();
+        uindex_t n_full_passes = n_generations / pipeline_length;
+        uindex_t n_remaining_generations = n_generations % pipeline_length;
+
+        double runtime = n_full_passes * Model::predict_pass(grid_range.c, grid_range.r)
+                                             .get_runtime(clock_frequency);
+        if (n_remaining_generations != 0) {
+            runtime += Model::predict_pass(grid_range.c, grid_range.r, n_remaining_generations)
+                           .get_runtime(clock_frequency);
+        }
+        results.push_back(Configuration::make_result(runtime));
+    }
+
+    template <typename Configuration>
+    static void measure_configuration(std::vector<TuningResult> &results, cl::sycl::queue queue,
+                                      cl::sycl::buffer<T, 2> input_buffer, uindex_t n_generations,
+                                      T halo_value, TransFunc trans_func) {
+        using Executor = ExecutorImpl<Configuration>;
+        if (!Configuration::supports_grid(input_buffer.get_range())) {
+            return;
+        }
+
+        Executor executor(halo_value, trans_func);
+        executor.set_queue(queue);
+        executor.set_input(input_buffer);
+
+        executor.run(Configuration::get_pipeline_length());
+        queue.wait();
+
+        auto start = std::chrono::steady_clock::now();
+        executor.run(n_generations);
+        queue.wait();
+        auto end = std::chrono::steady_clock::now();
+
+        results.push_back(
+            Configuration::make_result(std::chrono::duration<double>(end - start).count()));
+    }
+
+    static void sort_results(std::vector<TuningResult> &results) {
+        std::stable_sort(results.begin(), results.end(),
+                         [](TuningResult const &a, TuningResult const &b) {
+                             return a.runtime < b.runtime;
+                         });
+    }
+};
+} // namespace stencil
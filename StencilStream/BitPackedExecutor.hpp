@@ -0,0 +1,247 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "LifeLikeRule.hpp"
+#include "SingleQueueExecutor.hpp"
+#include "StencilExecutor.hpp"
+#include <type_traits>
+#include <utility>
+
+namespace stencil {
+/**
+ * \brief The transition function for grids of packed cells, used by \ref BitPackedExecutor.
+ *
+ * Every word contains `8 * sizeof(word_t)` consecutive cells of a grid column, where bit `i` of
+ * word `(c, r)` is the cell `(c, r * 8 * sizeof(word_t) + i)`. The north and south neighbors of
+ * the cells are obtained by shifting the word and inserting the adjacent bit of the neighboring
+ * word, so that a stencil of words with radius 1 contains all neighbors of all bits.
+ *
+ * The bits of the last word of a column that are below the grid are padding. They are always set
+ * to the halo value, so that they act as grid halo for the bits above them.
+ *
+ * \tparam word_t The type of the words. Must be an unsigned integer type.
+ */
+template <typename word_t> class BitPackedTransFunc {
+  public:
+    static_assert(std::is_unsigned<word_t>::value);
+
+    /**
+     * \brief The number of cells in a word.
+     */
+    static constexpr uindex_t word_bits = 8 * sizeof(word_t);
+
+    /**
+     * \brief Create a new transition function.
+     *
+     * \param rule The rule to apply to the cells.
+     * \param grid_height The number of cell rows in the grid.
+     * \param halo_value The value of cells outside the grid.
+     */
+    BitPackedTransFunc(LifeLikeRule rule, uindex_t grid_height, bool halo_value)
+        : rule(rule), grid_height(grid_height), halo_value(halo_value) {}
+
+    word_t operator()(Stencil<word_t, 1> const &stencil) const {
+        word_t neighbors[8];
+        uindex_t i_neighbor = 0;
+#pragma unroll
+        for (index_t c = -1; c <= 1; c++) {
+            word_t center = stencil[ID(c, 0)];
+            word_t north = word_t(center << 1) | word_t(stencil[ID(c, -1)] >> (word_bits - 1));
+            word_t south = word_t(center >> 1) | word_t(stencil[ID(c, 1)] << (word_bits - 1));
+
+            neighbors[i_neighbor++] = north;
+            neighbors[i_neighbor++] = south;
+            if (c != 0) {
+                neighbors[i_neighbor++] = center;
+            }
+        }
+
+        word_t new_word = rule.apply(stencil[ID(0, 0)], neighbors);
+
+        index_t n_valid_bits = index_t(grid_height) - stencil.id.r * index_t(word_bits);
+        if (n_valid_bits < index_t(word_bits)) {
+            word_t valid_mask = 0;
+            if (n_valid_bits > 0) {
+                valid_mask = word_t(~word_t(0)) >> (word_bits - n_valid_bits);
+            }
+            word_t halo_word = halo_value ? word_t(~word_t(0)) : word_t(0);
+            new_word = (new_word & valid_mask) | (halo_word & word_t(~valid_mask));
+        }
+        return new_word;
+    }
+
+  private:
+    LifeLikeRule rule;
+    uindex_t grid_height;
+    bool halo_value;
+};
+
+/**
+ * \brief An executor for life-like cellular automata that packs multiple cells into one word.
+ *
+ * Binary cells waste most of the bits of the buffers, pipes and stencil buffers if every cell
+ * occupies a full element. This executor packs `8 * sizeof(word_t)` consecutive cells of a grid
+ * column into one word, as described in \ref BitPackedTransFunc, and processes the words with a
+ * regular \ref StencilExecutor. The words travel through the unmodified IO and execution kernels
+ * and the rule is evaluated for all bits of a word in parallel with \ref LifeLikeRule.apply.
+ * Therefore, every cycle updates a complete word and the grid requires `8 * sizeof(word_t)` times
+ * less memory than a grid of `bool` cells, which are typically one byte wide.
+ *
+ * The grid is packed and unpacked on the host by \ref BitPackedExecutor.set_input and \ref
+ * BitPackedExecutor.copy_output. The runtime sample counts words instead of cells.
+ *
+ * \tparam word_t The type of the words. Must be an unsigned integer type. Defaults to `uint64_t`.
+ * \tparam pipeline_length The number of hardware execution stages per kernel. Must be at least 1.
+ * Defaults to 1.
+ * \tparam tile_width The number of columns in a tile. Defaults to 1024.
+ * \tparam tile_height The number of words in a tile column. A tile therefore contains
+ * `tile_height * 8 * sizeof(word_t)` cell rows. Defaults to 1024.
+ * \tparam burst_size The number of bytes to load/store in one burst. Defaults to 1024.
+ */
+template <typename word_t = uint64_t, uindex_t pipeline_length = 1, uindex_t tile_width = 1024,
+          uindex_t tile_height = 1024, uindex_t burst_size = 1024>
+class BitPackedExecutor : public SingleQueueExecutor<bool, 1, LifeLikeRule> {
+  public:
+    static_assert(std::is_unsigned<word_t>::value);
+
+    /**
+     * \brief Shorthand for the parent class.
+     */
+    using Parent = SingleQueueExecutor<bool, 1, LifeLikeRule>;
+
+    /**
+     * \brief The transition function for the packed words.
+     */
+    using PackedTransFunc = BitPackedTransFunc<word_t>;
+
+    /**
+     * \brief The type of the executor that processes the packed words.
+     */
+    using PackedExecutorImpl = StencilExecutor<word_t, 1, PackedTransFunc, pipeline_length,
+                                               tile_width, tile_height, burst_size>;
+
+    /**
+     * \brief The number of cells in a word.
+     */
+    static constexpr uindex_t word_bits = 8 * sizeof(word_t);
+
+    /**
+     * \brief Create a new executor.
+     *
+     * \param halo_value The value of cells in the grid halo.
+     * \param rule The rule of the cellular automaton.
+     */
+    BitPackedExecutor(bool halo_value, LifeLikeRule rule)
+        : Parent(halo_value, rule), packed_executor(get_halo_word(halo_value),
+                                                    PackedTransFunc(rule, 0, halo_value)),
+          grid_range(0, 0) {}
+
+    /**
+     * \brief Pack a grid of cells into words.
+     *
+     * \param cell_buffer The cells to pack.
+     * \param padding_value The value of the bits below the last row of the grid.
+     * \return A buffer with the same number of columns and `ceil(rows / (8 * sizeof(word_t)))`
+     * rows.
+     */
+    static cl::sycl::buffer<word_t, 2> pack(cl::sycl::buffer<bool, 2> cell_buffer,
+                                            bool padding_value) {
+        uindex_t width = cell_buffer.get_range()[0];
+        uindex_t height = cell_buffer.get_range()[1];
+        uindex_t n_words = (height + word_bits - 1) / word_bits;
+
+        cl::sycl::buffer<word_t, 2> word_buffer(cl::sycl::range<2>(width, n_words));
+        auto cell_ac = cell_buffer.template get_access<cl::sycl::access::mode::read>();
+        auto word_ac = word_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t i_word = 0; i_word < n_words; i_word++) {
+                word_t word = 0;
+                for (uindex_t i_bit = 0; i_bit < word_bits; i_bit++) {
+                    uindex_t r = i_word * word_bits + i_bit;
+                    bool cell = r < height ? cell_ac[c][r] : padding_value;
+                    word |= word_t(cell) << i_bit;
+                }
+                word_ac[c][i_word] = word;
+            }
+        }
+        return word_buffer;
+    }
+
+    /**
+     * \brief Unpack a grid of words into cells.
+     *
+     * \param word_buffer The words to unpack.
+     * \param cell_buffer The target buffer. Its range defines the number of unpacked cells.
+     * \throws std::range_error The word buffer does not contain all cells of the cell buffer.
+     */
+    static void unpack(cl::sycl::buffer<word_t, 2> word_buffer,
+                       cl::sycl::buffer<bool, 2> cell_buffer) {
+        uindex_t width = cell_buffer.get_range()[0];
+        uindex_t height = cell_buffer.get_range()[1];
+        if (word_buffer.get_range()[0] != width ||
+            word_buffer.get_range()[1] != (height + word_bits - 1) / word_bits) {
+            throw std::range_error("The word buffer does not match the cell buffer");
+        }
+
+        auto word_ac = word_buffer.template get_access<cl::sycl::access::mode::read>();
+        auto cell_ac = cell_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t r = 0; r < height; r++) {
+                cell_ac[c][r] = (word_ac[c][r / word_bits] >> (r % word_bits)) & 0b1;
+            }
+        }
+    }
+
+    void set_input(cl::sycl::buffer<bool, 2> input_buffer) override {
+        grid_range = UID(input_buffer.get_range()[0], input_buffer.get_range()[1]);
+        packed_executor.set_input(pack(input_buffer, this->get_halo_value()));
+    }
+
+    void copy_output(cl::sycl::buffer<bool, 2> output_buffer) override {
+        UID packed_range = packed_executor.get_grid_range();
+        cl::sycl::buffer<word_t, 2> word_buffer(cl::sycl::range<2>(packed_range.c, packed_range.r));
+        packed_executor.copy_output(word_buffer);
+        unpack(word_buffer, output_buffer);
+    }
+
+    UID get_grid_range() const override { return grid_range; }
+
+    void run(uindex_t n_generations) override {
+        packed_executor.set_halo_value(get_halo_word(this->get_halo_value()));
+        packed_executor.set_trans_func(
+            PackedTransFunc(this->get_trans_func(), grid_range.r, this->get_halo_value()));
+        packed_executor.set_i_generation(this->get_i_generation());
+        packed_executor.set_queue(this->get_queue());
+
+        std::swap(packed_executor.get_runtime_sample(), this->get_runtime_sample());
+        packed_executor.run(n_generations);
+        std::swap(packed_executor.get_runtime_sample(), this->get_runtime_sample());
+        this->set_i_generation(packed_executor.get_i_generation());
+    }
+
+  private:
+    static word_t get_halo_word(bool halo_value) {
+        return halo_value ? word_t(~word_t(0)) : word_t(0);
+    }
+
+    PackedExecutorImpl packed_executor;
+    UID grid_range;
+};
+} // namespace stencil
@@ -0,0 +1,187 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Index.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace stencil {
+/**
+ * \brief A bounded, lock-free single-producer/single-consumer pipe for the host.
+ *
+ * It has the same static interface as `cl::sycl::INTEL::pipe`, so kernel functors that are
+ * parameterized on their pipe types can be instantiated with it and executed as host threads:
+ * Every pipe is a singleton that is identified by the `id` type. Reads block while the pipe is
+ * empty and writes block while the pipe is full, which makes the pipe a faithful model of an FPGA
+ * pipe with the given capacity.
+ *
+ * The pipe is implemented as a ring buffer with one atomic index for each side. At any time, only
+ * one thread may read from the pipe and only one thread may write to it.
+ *
+ * Unlike an FPGA pipe, a host pipe can be closed with \ref BoundedHostPipe.close when a thread of a
+ * pipeline fails. Blocked and future reads and writes then throw an exception instead of waiting
+ * forever for the failed thread, and \ref BoundedHostPipe.reset prepares the pipe for the next use.
+ *
+ * \tparam id The type that identifies the pipe.
+ * \tparam T The type of the transferred values. It has to be default-constructible.
+ * \tparam capacity The maximal number of values in the pipe. Must be at least 1.
+ */
+template <typename id, typename T, uindex_t capacity = 64> class BoundedHostPipe {
+  public:
+    static_assert(capacity >= 1);
+
+    /**
+     * \brief Read a value from the pipe, waiting until one is available.
+     *
+     * \throws std::runtime_error Thrown if the pipe is closed while it is empty.
+     */
+    static T read() {
+        T value;
+        while (!try_read(value)) {
+            check_open();
+            std::this_thread::yield();
+        }
+        return value;
+    }
+
+    /**
+     * \brief Write a value to the pipe, waiting until there is space for it.
+     *
+     * \throws std::runtime_error Thrown if the pipe is closed.
+     */
+    static void write(T new_value) {
+        check_open();
+        while (!try_write(new_value)) {
+            check_open();
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * \brief Read a value from the pipe if one is available.
+     *
+     * \param value The variable to store the value in.
+     * \return True if a value has been read, false if the pipe is empty.
+     */
+    static bool try_read(T &value) {
+        RingBuffer &buffer = RingBuffer::instance();
+        std::size_t head = buffer.head.load(std::memory_order_relaxed);
+        if (head == buffer.tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = buffer.values[head];
+        buffer.head.store(next_index(head), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * \brief Write a value to the pipe if there is space for it.
+     *
+     * \param new_value The value to write.
+     * \return True if the value has been written, false if the pipe is full.
+     */
+    static bool try_write(T const &new_value) {
+        RingBuffer &buffer = RingBuffer::instance();
+        std::size_t tail = buffer.tail.load(std::memory_order_relaxed);
+        std::size_t next_tail = next_index(tail);
+        if (next_tail == buffer.head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        buffer.values[tail] = new_value;
+        buffer.tail.store(next_tail, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * \brief Check whether the pipe is empty.
+     *
+     * The result is only reliable if no other thread accesses the pipe concurrently.
+     */
+    static bool empty() {
+        RingBuffer &buffer = RingBuffer::instance();
+        return buffer.head.load(std::memory_order_acquire) ==
+               buffer.tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * \brief Close the pipe.
+     *
+     * Blocked and future calls of \ref BoundedHostPipe.read and \ref BoundedHostPipe.write throw
+     * an exception until the pipe is reset. This method may be called from any thread.
+     */
+    static void close() { RingBuffer::instance().closed.store(true, std::memory_order_release); }
+
+    /**
+     * \brief Check whether the pipe has been closed.
+     */
+    static bool is_closed() {
+        return RingBuffer::instance().closed.load(std::memory_order_acquire);
+    }
+
+    /**
+     * \brief Remove all values from the pipe and reopen it.
+     *
+     * No other thread may access the pipe concurrently.
+     */
+    static void reset() {
+        RingBuffer &buffer = RingBuffer::instance();
+        buffer.head.store(0, std::memory_order_relaxed);
+        buffer.tail.store(0, std::memory_order_relaxed);
+        buffer.closed.store(false, std::memory_order_release);
+    }
+
+  private:
+    static void check_open() {
+        if (is_closed()) {
+            throw std::runtime_error("The host pipe has been closed");
+        }
+    }
+
+    // One slot of the ring buffer always stays free to distinguish a full from an empty buffer.
+    static constexpr std::size_t n_slots = capacity + 1;
+
+    static std::size_t next_index(std::size_t index) {
+        return index + 1 == n_slots ? 0 : index + 1;
+    }
+
+    struct RingBuffer {
+        static RingBuffer &instance() {
+            static RingBuffer _instance;
+            return _instance;
+        }
+
+        RingBuffer() : head(0), tail(0), closed(false), values(new T[n_slots]()) {}
+        RingBuffer(RingBuffer const &) = delete;
+        RingBuffer &operator=(RingBuffer const &) = delete;
+
+        // The indices are placed on separate cache lines to avoid false sharing between the
+        // producer and the consumer.
+        alignas(64) std::atomic<std::size_t> head;
+        alignas(64) std::atomic<std::size_t> tail;
+        std::atomic<bool> closed;
+        // Not a std::vector, since the elements of std::vector<bool> can not be accessed
+        // concurrently.
+        std::unique_ptr<T[]> values;
+    };
+};
+} // namespace stencil
@@ -52,4 +52,14 @@ inline constexpr uindex_t next_power_of_two(uindex_t value) {
     }
     return next_power_of_two;
 }
+
+template <typename T> inline bool is_bitwise_equal(T const &a, T const &b) {
+    uint8_t const *a_bytes = reinterpret_cast<uint8_t const *>(&a);
+    uint8_t const *b_bytes = reinterpret_cast<uint8_t const *>(&b);
+    bool equal = true;
+    for (uindex_t i = 0; i < sizeof(T); i++) {
+        equal &= a_bytes[i] == b_bytes[i];
+    }
+    return equal;
+}
 } // namespace stencil
\ No newline at end of file
@@ -0,0 +1,234 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "AbstractExecutor.hpp"
+#include "BoundedHostPipe.hpp"
+#include "PerformanceModel.hpp"
+#include "tiling/ExecutionKernel.hpp"
+#include "tiling/Grid.hpp"
+#include <exception>
+#include <thread>
+
+namespace stencil {
+/**
+ * \brief An executor that runs the tiling kernels as host threads.
+ *
+ * This executor uses the same \ref tiling::Grid and the same \ref tiling::IOKernel and \ref
+ * tiling::ExecutionKernel instances as \ref StencilExecutor, but instead of submitting them to a
+ * SYCL queue, every kernel of a tile is executed by its own thread and the kernels are connected
+ * by \ref BoundedHostPipe instances. Therefore, it computes bit-identical results, but it does not
+ * require an FPGA or the FPGA emulator and its runtime does not depend on the emulator's
+ * scheduling. It is intended for fast functional tests of transition functions and for debugging
+ * with ordinary host tools.
+ *
+ * The pipes are identified by tag types that are members of the executor type. Therefore,
+ * executors of different types may run concurrently, but two instances of the same executor type
+ * must not.
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam TransFunc The type of the transition function.
+ * \tparam pipeline_length The number of execution stages per kernel. Must be at least 1. Defaults
+ * to 1.
+ * \tparam tile_width The number of columns in a tile. Defaults to 1024.
+ * \tparam tile_height The number of rows in a tile. Defaults to 1024.
+ * \tparam burst_size The number of bytes to load/store in one burst. Defaults to 1024.
+ * \tparam pipe_capacity The capacity of the pipes between the kernels. Defaults to 64.
+ */
+template <typename T, uindex_t stencil_radius, typename TransFunc, uindex_t pipeline_length = 1,
+          uindex_t tile_width = 1024, uindex_t tile_height = 1024, uindex_t burst_size = 1024,
+          uindex_t pipe_capacity = 64>
+class HostExecutor : public AbstractExecutor<T, stencil_radius, TransFunc> {
+  public:
+    /**
+     * \brief The number of cells that can be transfered in a single burst.
+     */
+    static constexpr uindex_t burst_length = std::max<uindex_t>(1, burst_size / sizeof(T));
+
+    /**
+     * \brief The number of cells that have be added to the tile in every direction to form the
+     * complete input.
+     */
+    static constexpr uindex_t halo_radius = stencil_radius * pipeline_length;
+
+    /**
+     * \brief Shorthand for the parent class.
+     */
+    using Parent = AbstractExecutor<T, stencil_radius, TransFunc>;
+
+    /**
+     * \brief The type of the internal grid.
+     */
+    using GridImpl = tiling::Grid<T, tile_width, tile_height, halo_radius, burst_length>;
+
+    /**
+     * \brief The type that identifies the \ref in_pipe of this executor type.
+     *
+     * It is declared as a member, so that every instantiation of the executor has its own type.
+     * A tag that is declared in the template argument list would be declared in the enclosing
+     * namespace and would therefore be shared by all instantiations.
+     */
+    class in_pipe_id;
+
+    /**
+     * \brief The type that identifies the \ref out_pipe of this executor type.
+     */
+    class out_pipe_id;
+
+    /**
+     * \brief The pipe from the input kernels to the execution kernel.
+     */
+    using in_pipe = BoundedHostPipe<in_pipe_id, T, pipe_capacity>;
+
+    /**
+     * \brief The pipe from the execution kernel to the output kernels.
+     */
+    using out_pipe = BoundedHostPipe<out_pipe_id, T, pipe_capacity>;
+
+    /**
+     * \brief The type of the execution kernel.
+     */
+    using ExecutionKernelImpl =
+        tiling::ExecutionKernel<TransFunc, T, stencil_radius, pipeline_length, tile_width,
+                                tile_height, in_pipe, out_pipe>;
+
+    /**
+     * \brief The analytical performance model of this executor's configuration.
+     *
+     * Since the host executor runs the same kernels as the \ref StencilExecutor, it computes the
+     * same number of cell updates.
+     */
+    using PerformanceModel =
+        TilingPerformanceModel<T, stencil_radius, pipeline_length, tile_width, tile_height>;
+
+    /**
+     * \brief Create a new host executor.
+     *
+     * \param halo_value The value of cells in the grid halo.
+     * \param trans_func An instance of the transition function type.
+     */
+    HostExecutor(T halo_value, TransFunc trans_func)
+        : Parent(halo_value, trans_func),
+          input_grid(cl::sycl::buffer<T, 2>(cl::sycl::range<2>(0, 0))) {}
+
+    void set_input(cl::sycl::buffer<T, 2> input_buffer) override {
+        this->input_grid = GridImpl(input_buffer);
+    }
+
+    void copy_output(cl::sycl::buffer<T, 2> output_buffer) override {
+        input_grid.copy_to(output_buffer);
+    }
+
+    UID get_grid_range() const override { return input_grid.get_grid_range(); }
+
+    void run(uindex_t n_generations) override {
+        uindex_t target_i_generation = this->get_i_generation() + n_generations;
+
+        while (this->get_i_generation() < target_i_generation) {
+            input_grid = run_pass(input_grid, target_i_generation);
+
+            this->inc_i_generation(
+                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+        }
+    }
+
+  private:
+    /**
+     * \brief Run all kernels of one pass over the grid.
+     *
+     * The tiles are processed one after another. For every tile, the input kernels and the
+     * execution kernel are run by two additional threads while the calling thread runs the output
+     * kernels. All threads are joined before the next tile is processed, so that the pipes are
+     * empty at the start of every tile.
+     *
+     * If a kernel throws an exception, the pipes are closed so that the other kernels stop waiting
+     * for it. Once all threads are joined, the pipes are reset and the first exception is rethrown
+     * on the calling thread.
+     *
+     * \param pass_input_grid The grid to read the cells from.
+     * \param target_i_generation The generation index to compute. At most `pipeline_length`
+     * generations are computed.
+     * \return The output grid of the pass.
+     */
+    GridImpl run_pass(GridImpl &pass_input_grid, uindex_t target_i_generation) {
+        this->check_pass_start(this->get_i_generation());
+        uindex_t grid_width = pass_input_grid.get_grid_range().c;
+        uindex_t grid_height = pass_input_grid.get_grid_range().r;
+
+        GridImpl output_grid = pass_input_grid.make_output_grid();
+        UID tile_range = pass_input_grid.get_tile_range();
+
+        for (uindex_t c = 0; c < tile_range.c; c++) {
+            for (uindex_t r = 0; r < tile_range.r; r++) {
+                ExecutionKernelImpl kernel(this->get_trans_func(), this->get_i_generation(),
+                                           target_i_generation, c * tile_width, r * tile_height,
+                                           grid_width, grid_height, this->get_halo_value());
+
+                std::exception_ptr input_exception, execution_exception, output_exception;
+                std::thread input_thread([&pass_input_grid, &input_exception, c, r]() {
+                    input_exception = run_guarded(
+                        [&]() { pass_input_grid.template run_tile_input<in_pipe>(UID(c, r)); });
+                });
+                std::thread execution_thread([kernel, &execution_exception]() {
+                    execution_exception = run_guarded(kernel);
+                });
+                output_exception = run_guarded(
+                    [&]() { output_grid.template run_tile_output<out_pipe>(UID(c, r)); });
+
+                input_thread.join();
+                execution_thread.join();
+
+                if (in_pipe::is_closed()) {
+                    in_pipe::reset();
+                    out_pipe::reset();
+                    for (std::exception_ptr exception :
+                         {input_exception, execution_exception, output_exception}) {
+                        if (exception) {
+                            std::rethrow_exception(exception);
+                        }
+                    }
+                }
+            }
+        }
+
+        return output_grid;
+    }
+
+    /**
+     * \brief Run a kernel and close both pipes if it throws an exception.
+     *
+     * \return The exception thrown by the kernel, or a null pointer if it succeeded or if the
+     * pipes had already been closed because of another kernel's exception.
+     */
+    template <typename Kernel> static std::exception_ptr run_guarded(Kernel const &kernel) {
+        try {
+            kernel();
+            return nullptr;
+        } catch (...) {
+            bool is_cause = !in_pipe::is_closed();
+            in_pipe::close();
+            out_pipe::close();
+            return is_cause ? std::current_exception() : nullptr;
+        }
+    }
+
+    GridImpl input_grid;
+};
+} // namespace stencil
@@ -0,0 +1,144 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Index.hpp"
+#include "Stencil.hpp"
+#include <cstdint>
+#include <type_traits>
+
+namespace stencil {
+/**
+ * \brief A transition function for life-like cellular automata.
+ *
+ * Life-like automata have binary cells and the new state of a cell only depends on its current
+ * state and the number of alive cells in its Moore neighborhood. A rule is described by two masks:
+ * A dead cell with `n` alive neighbors becomes alive if bit `n` of the birth mask is set, and an
+ * alive cell with `n` alive neighbors stays alive if bit `n` of the survival mask is set. Conway's
+ * Game of Life, B3/S23, is provided by \ref LifeLikeRule.conway.
+ *
+ * The rule can be used as a regular transition function for `bool` cells. Additionally, \ref
+ * LifeLikeRule.apply evaluates it bit-parallel for words of packed cells, which is used by \ref
+ * BitPackedExecutor.
+ */
+class LifeLikeRule {
+  public:
+    /**
+     * \brief Create a new rule.
+     *
+     * \param birth_mask Bit `n` is set if a dead cell with `n` alive neighbors becomes alive.
+     * \param survival_mask Bit `n` is set if an alive cell with `n` alive neighbors stays alive.
+     */
+    LifeLikeRule(uint16_t birth_mask, uint16_t survival_mask)
+        : birth_mask(birth_mask), survival_mask(survival_mask) {}
+
+    /**
+     * \brief Create the rule of Conway's Game of Life, B3/S23.
+     */
+    static LifeLikeRule conway() { return LifeLikeRule(1 << 3, (1 << 2) | (1 << 3)); }
+
+    /**
+     * \brief Get the birth mask of the rule.
+     */
+    uint16_t get_birth_mask() const { return birth_mask; }
+
+    /**
+     * \brief Get the survival mask of the rule.
+     */
+    uint16_t get_survival_mask() const { return survival_mask; }
+
+    /**
+     * \brief Compute the new state of a single cell.
+     */
+    bool operator()(Stencil<bool, 1> const &stencil) const {
+        uindex_t n_alive_neighbors = 0;
+#pragma unroll
+        for (index_t c = -1; c <= 1; c++) {
+#pragma unroll
+            for (index_t r = -1; r <= 1; r++) {
+                if ((c != 0 || r != 0) && stencil[ID(c, r)]) {
+                    n_alive_neighbors += 1;
+                }
+            }
+        }
+
+        if (stencil[ID(0, 0)]) {
+            return (survival_mask >> n_alive_neighbors) & 0b1;
+        } else {
+            return (birth_mask >> n_alive_neighbors) & 0b1;
+        }
+    }
+
+    /**
+     * \brief Compute the new states of all cells in a word of packed cells.
+     *
+     * Every bit of the words is an independent cell. The neighbor counts of all bits are computed
+     * at once in four bit planes, which are then compared with every count that is enabled in the
+     * masks.
+     *
+     * \tparam word_t The type of the words. Must be an unsigned integer type.
+     * \param alive The current states of the cells.
+     * \param neighbors The states of the eight neighbors of every cell, in arbitrary order. Bit
+     * `i` of every word is a neighbor of bit `i` of `alive`.
+     * \return The new states of the cells.
+     */
+    template <typename word_t> word_t apply(word_t alive, word_t const neighbors[8]) const {
+        static_assert(std::is_unsigned<word_t>::value);
+
+        // Ripple-carry addition of all neighbors into the bit planes of the counts.
+        word_t count_planes[4] = {0, 0, 0, 0};
+#pragma unroll
+        for (uindex_t i = 0; i < 8; i++) {
+            word_t carry = neighbors[i];
+#pragma unroll
+            for (uindex_t plane = 0; plane < 4; plane++) {
+                word_t next_carry = count_planes[plane] & carry;
+                count_planes[plane] ^= carry;
+                carry = next_carry;
+            }
+        }
+
+        word_t new_alive = 0;
+#pragma unroll
+        for (uindex_t n = 0; n <= 8; n++) {
+            word_t has_count = word_t(~word_t(0));
+#pragma unroll
+            for (uindex_t plane = 0; plane < 4; plane++) {
+                if ((n >> plane) & 0b1) {
+                    has_count &= count_planes[plane];
+                } else {
+                    has_count &= word_t(~count_planes[plane]);
+                }
+            }
+
+            if ((survival_mask >> n) & 0b1) {
+                new_alive |= has_count & alive;
+            }
+            if ((birth_mask >> n) & 0b1) {
+                new_alive |= has_count & word_t(~alive);
+            }
+        }
+        return new_alive;
+    }
+
+  private:
+    uint16_t birth_mask;
+    uint16_t survival_mask;
+};
+} // namespace stencil
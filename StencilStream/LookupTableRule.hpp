@@ -0,0 +1,222 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Index.hpp"
+#include "Stencil.hpp"
+#include "StencilExecutor.hpp"
+#include <cctype>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace stencil {
+/**
+ * \brief A transition function for outer-totalistic cellular automata that is defined by a table.
+ *
+ * The new state of a cell only depends on its current state and on the number of alive cells in
+ * its Moore neighborhood, where a cell is alive if its state is 1. The new state is therefore
+ * looked up in a table with one row for every state and one column for every possible number of
+ * alive neighbors. Since the table is a member of the transition function, it is passed to the
+ * execution kernel as an argument and stored on-chip. Rules can therefore be replaced at runtime
+ * with \ref AbstractExecutor.set_trans_func, without synthesizing a new design, and every cell
+ * update is a single lookup.
+ *
+ * The table can be filled entry by entry or from a rule string with \ref LookupTableRule.parse,
+ * which supports life-like rules like `B3/S23` and Generations rules like `B2/S/C3`.
+ *
+ * \tparam state_t The type of the cell states. Must be an unsigned integer type.
+ * \tparam n_states The number of states. All cells must have a state less than this number.
+ * Defaults to 2.
+ * \tparam stencil_radius The radius of the neighborhood. Defaults to 1.
+ */
+template <typename state_t = uint8_t, uindex_t n_states = 2, uindex_t stencil_radius = 1>
+class LookupTableRule {
+  public:
+    static_assert(std::is_unsigned<state_t>::value);
+    static_assert(n_states >= 2);
+
+    /**
+     * \brief The number of cells in the neighborhood of a cell, excluding the cell itself.
+     */
+    static constexpr uindex_t n_neighbors =
+        (2 * stencil_radius + 1) * (2 * stencil_radius + 1) - 1;
+
+    /**
+     * \brief Create a new rule that maps all cells to state 0.
+     */
+    LookupTableRule() : table() {}
+
+    /**
+     * \brief Create a Generations rule.
+     *
+     * A dead cell (state 0) becomes alive (state 1) if bit `n` of the birth mask is set, where `n`
+     * is the number of alive neighbors. An alive cell stays alive if bit `n` of the survival mask
+     * is set, and starts to die otherwise. Dying cells advance by one state in every generation
+     * until they reach the state `n_rule_states`, which is equivalent to 0. With two rule states,
+     * this is a life-like rule.
+     *
+     * \param birth_mask The neighbor counts that cause a birth.
+     * \param survival_mask The neighbor counts that let an alive cell survive.
+     * \param n_rule_states The number of states used by the rule. Defaults to 2.
+     * \throws std::invalid_argument The rule uses less than two or more than `n_states` states.
+     */
+    static LookupTableRule generations(uint32_t birth_mask, uint32_t survival_mask,
+                                       uindex_t n_rule_states = 2) {
+        if (n_rule_states < 2 || n_rule_states > n_states) {
+            throw std::invalid_argument("The rule requires an unsupported number of states");
+        }
+
+        LookupTableRule rule;
+        for (uindex_t n = 0; n <= n_neighbors; n++) {
+            bool birth = n < 32 && ((birth_mask >> n) & 0b1);
+            bool survival = n < 32 && ((survival_mask >> n) & 0b1);
+
+            rule.set_transition(0, n, birth ? 1 : 0);
+            rule.set_transition(1, n, survival ? 1 : (2 % n_rule_states));
+            for (uindex_t state = 2; state < n_rule_states; state++) {
+                rule.set_transition(state, n, (state + 1) % n_rule_states);
+            }
+        }
+        return rule;
+    }
+
+    /**
+     * \brief Create a rule from a rule string.
+     *
+     * Life-like rules are written as `B<counts>/S<counts>`, for example `B3/S23` for Conway's Game
+     * of Life, where the counts are single digits. Generations rules have an additional `/C<n>`
+     * part with the number of states, for example `B2/S/C3` for Brian's Brain.
+     *
+     * \param rule_string The rule string.
+     * \throws std::invalid_argument The rule string is malformed or the rule requires more than
+     * `n_states` states.
+     */
+    static LookupTableRule parse(std::string const &rule_string) {
+        uint32_t masks[2] = {0, 0};
+        uindex_t n_rule_states = 2;
+        std::string const prefixes = "BSC";
+
+        uindex_t i_part = 0;
+        uindex_t i = 0;
+        while (i < rule_string.size()) {
+            if (i_part >= 3 || std::toupper(rule_string[i]) != prefixes[i_part]) {
+                throw std::invalid_argument("Malformed rule string: " + rule_string);
+            }
+            i++;
+
+            if (i_part == 2) {
+                std::string number = rule_string.substr(i);
+                if (number.empty() ||
+                    number.find_first_not_of("0123456789") != std::string::npos) {
+                    throw std::invalid_argument("Malformed rule string: " + rule_string);
+                }
+                try {
+                    n_rule_states = std::stoul(number);
+                } catch (std::logic_error const &) {
+                    // std::stoul throws std::out_of_range if the number is too big.
+                    throw std::invalid_argument("Malformed rule string: " + rule_string);
+                }
+                i = rule_string.size();
+            } else {
+                while (i < rule_string.size() && rule_string[i] != '/') {
+                    if (rule_string[i] < '0' || rule_string[i] > '8') {
+                        throw std::invalid_argument("Malformed rule string: " + rule_string);
+                    }
+                    masks[i_part] |= 1 << (rule_string[i] - '0');
+                    i++;
+                }
+                if (i < rule_string.size()) {
+                    i++;
+                    if (i == rule_string.size()) {
+                        // A separator has to be followed by another part.
+                        throw std::invalid_argument("Malformed rule string: " + rule_string);
+                    }
+                }
+            }
+            i_part++;
+        }
+        if (i_part < 2) {
+            throw std::invalid_argument("Malformed rule string: " + rule_string);
+        }
+
+        return generations(masks[0], masks[1], n_rule_states);
+    }
+
+    /**
+     * \brief Get the new state of a cell.
+     *
+     * \param state The current state of the cell.
+     * \param n_alive_neighbors The number of alive cells in the neighborhood of the cell.
+     * \throws std::out_of_range The state or the number of neighbors is too big.
+     */
+    state_t get_transition(uindex_t state, uindex_t n_alive_neighbors) const {
+        if (state >= n_states || n_alive_neighbors > n_neighbors) {
+            throw std::out_of_range("The transition is outside of the table");
+        }
+        return table[state][n_alive_neighbors];
+    }
+
+    /**
+     * \brief Set the new state of a cell.
+     *
+     * \param state The current state of the cell.
+     * \param n_alive_neighbors The number of alive cells in the neighborhood of the cell.
+     * \param new_state The new state of the cell.
+     * \throws std::out_of_range The states or the number of neighbors are too big.
+     */
+    void set_transition(uindex_t state, uindex_t n_alive_neighbors, uindex_t new_state) {
+        if (state >= n_states || new_state >= n_states || n_alive_neighbors > n_neighbors) {
+            throw std::out_of_range("The transition is outside of the table");
+        }
+        table[state][n_alive_neighbors] = new_state;
+    }
+
+    state_t operator()(Stencil<state_t, stencil_radius> const &stencil) const {
+        uindex_t n_alive_neighbors = 0;
+#pragma unroll
+        for (index_t c = -index_t(stencil_radius); c <= index_t(stencil_radius); c++) {
+#pragma unroll
+            for (index_t r = -index_t(stencil_radius); r <= index_t(stencil_radius); r++) {
+                if ((c != 0 || r != 0) && stencil[ID(c, r)] == 1) {
+                    n_alive_neighbors += 1;
+                }
+            }
+        }
+        return table[stencil[ID(0, 0)]][n_alive_neighbors];
+    }
+
+  private:
+    state_t table[n_states][n_neighbors + 1];
+};
+
+/**
+ * \brief A tiling executor for cellular automata with a \ref LookupTableRule.
+ *
+ * \tparam state_t The type of the cell states.
+ * \tparam n_states The number of states.
+ * \tparam pipeline_length The number of hardware execution stages per kernel. Defaults to 1.
+ * \tparam tile_width The number of columns in a tile. Defaults to 1024.
+ * \tparam tile_height The number of rows in a tile. Defaults to 1024.
+ */
+template <typename state_t = uint8_t, uindex_t n_states = 2, uindex_t pipeline_length = 1,
+          uindex_t tile_width = 1024, uindex_t tile_height = 1024>
+using LookupTableExecutor = StencilExecutor<state_t, 1, LookupTableRule<state_t, n_states, 1>,
+                                            pipeline_length, tile_width, tile_height>;
+} // namespace stencil
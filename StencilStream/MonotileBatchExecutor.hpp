@@ -0,0 +1,319 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "PerformanceModel.hpp"
+#include "SingleQueueExecutor.hpp"
+#include "monotile/ExecutionKernel.hpp"
+#include <vector>
+
+namespace stencil {
+/**
+ * \brief An executor that follows \ref monotile and works on a batch of independent grids.
+ *
+ * Every invocation of the monotile execution kernel has to fill its pipeline before it emits the
+ * first cell, which takes `pipeline_length * stencil_radius * (tile_height + 1)` iterations. For
+ * small grids, this latency is a significant part of the runtime. This executor therefore streams
+ * all grids of a batch back-to-back through a single invocation of the execution kernel, paying the
+ * latency only once per pass. The grids are separated by the tile borders: Every grid is padded to
+ * the full tile and cells from neighboring grids in the stream are treated like cells outside of
+ * the grid and are therefore replaced with the halo value.
+ *
+ * All grids of a batch need to have the same range, which may not exceed the tile range, and they
+ * all share the same transition function instance, halo value and generation index. The methods
+ * inherited from \ref AbstractExecutor work on a batch of one grid.
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam TransFunc The type of the transition function.
+ * \tparam pipeline_length The number of hardware execution stages per kernel. Must be at least 1.
+ * Defaults to 1.
+ * \tparam tile_width The number of columns in a tile and maximum number of columns in a grid.
+ * Defaults to 1024.
+ * \tparam tile_height The number of rows in a tile and maximum number of rows in a grid. Defaults
+ * to 1024.
+ */
+template <typename T, uindex_t stencil_radius, typename TransFunc, uindex_t pipeline_length = 1,
+          uindex_t tile_width = 1024, uindex_t tile_height = 1024>
+class MonotileBatchExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc> {
+  public:
+    /**
+     * \brief Shorthand for the parent class.
+     */
+    using Parent = SingleQueueExecutor<T, stencil_radius, TransFunc>;
+
+    /**
+     * \brief The analytical performance model of this executor's configuration.
+     */
+    using PerformanceModel =
+        MonotilePerformanceModel<T, stencil_radius, pipeline_length, tile_width, tile_height>;
+
+    /**
+     * \brief Create a new executor with an empty batch.
+     *
+     * \param halo_value The value of cells in the grid halo.
+     * \param trans_func An instance of the transition function type.
+     */
+    MonotileBatchExecutor(T halo_value, TransFunc trans_func)
+        : Parent(halo_value, trans_func), grid_buffers(), grid_range(0, 0),
+          grid_runtime_samples() {}
+
+    /**
+     * \brief Set the internal state of all grids of the batch.
+     *
+     * This will copy the contents of the buffers to an internal representation. The buffers may be
+     * used for other purposes later. It does not reset the generation index. The number of buffers
+     * will be used as the new batch size and their common range will be used as the new grid
+     * range. The runtime samples of the individual grids are reset.
+     *
+     * \param input_buffers The source buffers of the new grid states.
+     * \throws std::invalid_argument Thrown if no buffers are given or if the buffers don't have the
+     * same range.
+     * \throws std::range_error Thrown if the width or height of the buffers exceeds the width or
+     * height of the tile.
+     */
+    void set_inputs(std::vector<cl::sycl::buffer<T, 2>> const &input_buffers) {
+        if (input_buffers.empty()) {
+            throw std::invalid_argument("The batch has to contain at least one grid");
+        }
+        cl::sycl::range<2> new_grid_range = input_buffers[0].get_range();
+        if (new_grid_range[0] > tile_width || new_grid_range[1] > tile_height) {
+            throw std::range_error("The grid is bigger than the tile. The monotile architecture "
+                                   "requires that grid ranges are smaller or equal to the tile "
+                                   "range");
+        }
+
+        std::vector<cl::sycl::buffer<T, 2>> new_grid_buffers;
+        new_grid_buffers.reserve(input_buffers.size());
+        for (cl::sycl::buffer<T, 2> input_buffer : input_buffers) {
+            if (input_buffer.get_range() != new_grid_range) {
+                throw std::invalid_argument("All grids of a batch need to have the same range");
+            }
+
+            cl::sycl::buffer<T, 2> grid_buffer(new_grid_range);
+            auto in_ac = input_buffer.template get_access<cl::sycl::access::mode::read>();
+            auto grid_ac = grid_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+            for (uindex_t c = 0; c < new_grid_range[0]; c++) {
+                for (uindex_t r = 0; r < new_grid_range[1]; r++) {
+                    grid_ac[c][r] = in_ac[c][r];
+                }
+            }
+            new_grid_buffers.push_back(grid_buffer);
+        }
+
+        grid_buffers = new_grid_buffers;
+        grid_range = UID(new_grid_range);
+        grid_runtime_samples = std::vector<RuntimeSample>(grid_buffers.size());
+    }
+
+    /**
+     * \brief Copy the states of all grids of the batch to the given buffers.
+     *
+     * \param output_buffers The target buffers, one for every grid in the batch.
+     * \throws std::invalid_argument Thrown if the number of buffers is not equal to the batch size.
+     * \throws std::range_error Thrown if the range of one of the buffers is not equal to the grid
+     * range.
+     */
+    void copy_outputs(std::vector<cl::sycl::buffer<T, 2>> const &output_buffers) {
+        if (output_buffers.size() != grid_buffers.size()) {
+            throw std::invalid_argument("The number of output buffers is not the batch size");
+        }
+
+        for (uindex_t i_grid = 0; i_grid < grid_buffers.size(); i_grid++) {
+            cl::sycl::buffer<T, 2> output_buffer = output_buffers[i_grid];
+            if (output_buffer.get_range() != cl::sycl::range<2>(grid_range.c, grid_range.r)) {
+                throw std::range_error("The output buffer is not the same size as the grid");
+            }
+
+            auto in_ac = grid_buffers[i_grid].template get_access<cl::sycl::access::mode::read>();
+            auto out_ac =
+                output_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+            for (uindex_t c = 0; c < grid_range.c; c++) {
+                for (uindex_t r = 0; r < grid_range.r; r++) {
+                    out_ac[c][r] = in_ac[c][r];
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Set the internal state of the grid, as a batch of one grid.
+     *
+     * \throws std::range_error Thrown if the width or height of the buffer exceeds the width or
+     * height of the tile.
+     * \param input_buffer The source buffer of the new grid state.
+     */
+    void set_input(cl::sycl::buffer<T, 2> input_buffer) override { set_inputs({input_buffer}); }
+
+    /**
+     * \brief Copy the state of the grid to a buffer.
+     *
+     * \throws std::logic_error Thrown if the batch does not contain exactly one grid. Use \ref
+     * MonotileBatchExecutor.copy_outputs for bigger batches.
+     * \throws std::range_error Thrown if the range of the buffer is not equal to the grid range.
+     * \param output_buffer The target buffer.
+     */
+    void copy_output(cl::sycl::buffer<T, 2> output_buffer) override {
+        if (grid_buffers.size() != 1) {
+            throw std::logic_error("The batch does not contain exactly one grid");
+        }
+        copy_outputs({output_buffer});
+    }
+
+    UID get_grid_range() const override { return grid_range; }
+
+    /**
+     * \brief Get the number of grids in the batch.
+     */
+    uindex_t get_batch_size() const { return grid_buffers.size(); }
+
+    /**
+     * \brief Return a reference to the runtime information of a single grid in the batch.
+     *
+     * The runtime of a grid in a pass is the time between the completion of the previous grid's
+     * output and the completion of its own output. The first grid is measured from the start of
+     * the execution kernel and therefore also contains the latency of the pipeline. The runtime
+     * information of the whole batch is available via \ref SingleQueueExecutor.get_runtime_sample.
+     *
+     * \param i_grid The index of the grid in the batch.
+     * \return The collected runtime information.
+     * \throws std::out_of_range Thrown if the index is not smaller than the batch size.
+     */
+    RuntimeSample &get_grid_runtime_sample(uindex_t i_grid) {
+        return grid_runtime_samples.at(i_grid);
+    }
+
+    void run(uindex_t n_generations) override {
+        using in_pipe = cl::sycl::pipe<class monotile_batch_in_pipe, T>;
+        using out_pipe = cl::sycl::pipe<class monotile_batch_out_pipe, T>;
+        using ExecutionKernelImpl =
+            monotile::ExecutionKernel<TransFunc, T, stencil_radius, pipeline_length, tile_width,
+                                      tile_height, in_pipe, out_pipe>;
+
+        cl::sycl::queue &queue = this->get_queue();
+
+        uindex_t target_i_generation = this->get_i_generation() + n_generations;
+        uindex_t grid_width = grid_range.c;
+        uindex_t grid_height = grid_range.r;
+        uindex_t batch_size = grid_buffers.size();
+
+        while (this->get_i_generation() < target_i_generation) {
+            this->check_pass_start(this->get_i_generation());
+
+            std::vector<cl::sycl::event> input_events;
+            input_events.reserve(batch_size);
+
+            for (cl::sycl::buffer<T, 2> grid_buffer : grid_buffers) {
+                cl::sycl::event input_event = queue.submit([&](cl::sycl::handler &cgh) {
+                    auto ac = grid_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
+                    T halo_value = this->get_halo_value();
+
+                    cgh.single_task<class MonotileBatchInputKernel>([=]() {
+                        [[intel::loop_coalesce(2)]] for (uindex_t c = 0; c < tile_width; c++) {
+                            for (uindex_t r = 0; r < tile_height; r++) {
+                                T value;
+                                if (c < grid_width && r < grid_height) {
+                                    value = ac[c][r];
+                                } else {
+                                    value = halo_value;
+                                }
+
+                                in_pipe::write(value);
+                            }
+                        }
+                    });
+                });
+                input_events.push_back(input_event);
+            }
+
+            cl::sycl::event computation_event = queue.submit([&](cl::sycl::handler &cgh) {
+                cgh.single_task(ExecutionKernelImpl(
+                    this->get_trans_func(), this->get_i_generation(), target_i_generation,
+                    grid_width, grid_height, this->get_halo_value(), batch_size));
+            });
+
+            std::vector<cl::sycl::buffer<T, 2>> out_buffers;
+            std::vector<cl::sycl::event> output_events;
+            out_buffers.reserve(batch_size);
+            output_events.reserve(batch_size);
+
+            for (uindex_t i_grid = 0; i_grid < batch_size; i_grid++) {
+                cl::sycl::buffer<T, 2> out_buffer(cl::sycl::range<2>(grid_width, grid_height));
+
+                cl::sycl::event output_event = queue.submit([&](cl::sycl::handler &cgh) {
+                    auto ac =
+                        out_buffer.template get_access<cl::sycl::access::mode::discard_write>(cgh);
+
+                    cgh.single_task<class MonotileBatchOutputKernel>([=]() {
+                        [[intel::loop_coalesce(2)]] for (uindex_t c = 0; c < tile_width; c++) {
+                            for (uindex_t r = 0; r < tile_height; r++) {
+                                T value = out_pipe::read();
+                                if (c < grid_width && r < grid_height) {
+                                    ac[c][r] = value;
+                                }
+                            }
+                        }
+                    });
+                });
+
+                out_buffers.push_back(out_buffer);
+                output_events.push_back(output_event);
+            }
+
+            grid_buffers = out_buffers;
+
+            if (this->is_runtime_analysis_enabled()) {
+                // Every grid of the batch is recorded as a tile, with its index as column index.
+                RuntimeSample &sample = this->get_runtime_sample();
+                double n_bytes = double(grid_width) * grid_height * sizeof(T);
+                for (uindex_t i_grid = 0; i_grid < batch_size; i_grid++) {
+                    sample.add_kernel(RuntimeSample::KernelCategory::INPUT, UID(i_grid, 0),
+                                      input_events[i_grid], n_bytes);
+                }
+                sample.add_kernel(RuntimeSample::KernelCategory::EXECUTION, UID(0, 0),
+                                  computation_event);
+                for (uindex_t i_grid = 0; i_grid < batch_size; i_grid++) {
+                    sample.add_kernel(RuntimeSample::KernelCategory::OUTPUT, UID(i_grid, 0),
+                                      output_events[i_grid], n_bytes);
+                }
+
+                double pass_start = RuntimeSample::start_of_event(computation_event);
+                double previous_end = pass_start;
+                for (uindex_t i_grid = 0; i_grid < batch_size; i_grid++) {
+                    double grid_end = RuntimeSample::end_of_event(output_events[i_grid]);
+                    grid_runtime_samples[i_grid].add_pass(grid_end - previous_end);
+                    previous_end = grid_end;
+                }
+                uindex_t pass_length =
+                    std::min(target_i_generation - this->get_i_generation(), pipeline_length);
+                sample.add_pass(previous_end - pass_start,
+                                double(grid_width) * grid_height * batch_size * pass_length);
+            }
+
+            this->inc_i_generation(
+                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+        }
+    }
+
+  private:
+    std::vector<cl::sycl::buffer<T, 2>> grid_buffers;
+    UID grid_range;
+    std::vector<RuntimeSample> grid_runtime_samples;
+};
+} // namespace stencil
@@ -21,8 +21,12 @@
  * SOFTWARE.
  */
 #pragma once
+#include "PerformanceModel.hpp"
+#include "Reduction.hpp"
 #include "SingleQueueExecutor.hpp"
 #include "monotile/ExecutionKernel.hpp"
+#include <optional>
+#include <type_traits>
 
 namespace stencil {
 template <typename T, uindex_t stencil_radius, typename TransFunc, uindex_t pipeline_length = 1,
@@ -51,6 +55,12 @@ class MonotileExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc
      */
     using Parent = SingleQueueExecutor<T, stencil_radius, TransFunc>;
 
+    /**
+     * \brief The analytical performance model of this executor's configuration.
+     */
+    using PerformanceModel =
+        MonotilePerformanceModel<T, stencil_radius, pipeline_length, tile_width, tile_height>;
+
     /**
      * \brief Create a new executor.
      *
@@ -103,81 +113,264 @@ class MonotileExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc
         }
     }
 
+    /**
+     * \brief Copy a strided region of the grid to a buffer.
+     *
+     * The cell `(c, r)` of the output buffer is set to the grid cell `(region_offset.c + c *
+     * stride.c, region_offset.r + r * stride.r)`, which means that the output buffer must have the
+     * range `ceil(region_range / stride)`. The cells are picked on the device, so
+     * that only the requested cells are transferred.
+     *
+     * \param output_buffer The target buffer.
+     * \param region_offset The index of the north-western corner of the region.
+     * \param region_range The number of columns and rows of the region.
+     * \param stride The distance between two copied cells in every direction.
+     * \throws std::invalid_argument The stride is zero in any direction.
+     * \throws std::out_of_range The region exceeds the grid.
+     * \throws std::range_error The output buffer does not have the required range.
+     */
+    void copy_output(cl::sycl::buffer<T, 2> output_buffer, UID region_offset, UID region_range,
+                     UID stride = UID(1, 1)) {
+        if (stride.c == 0 || stride.r == 0) {
+            throw std::invalid_argument("The stride must not be zero");
+        }
+        if (region_offset.c + region_range.c > get_grid_range().c ||
+            region_offset.r + region_range.r > get_grid_range().r) {
+            throw std::out_of_range("The requested region exceeds the grid");
+        }
+        cl::sycl::range<2> output_range((region_range.c + stride.c - 1) / stride.c,
+                                        (region_range.r + stride.r - 1) / stride.r);
+        if (output_buffer.get_range() != output_range) {
+            throw std::range_error("The output buffer does not have the range of the region");
+        }
+
+        cl::sycl::buffer<T, 2> in_buffer = tile_buffer;
+        this->get_queue().submit([&](cl::sycl::handler &cgh) {
+            auto in_ac = in_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
+            auto out_ac =
+                output_buffer.template get_access<cl::sycl::access::mode::discard_write>(cgh);
+
+            cgh.single_task<class MonotileRegionCopyKernel>([=]() {
+                for (uindex_t c = 0; c < output_range[0]; c++) {
+                    for (uindex_t r = 0; r < output_range[1]; r++) {
+                        out_ac[c][r] =
+                            in_ac[region_offset.c + c * stride.c][region_offset.r + r * stride.r];
+                    }
+                }
+            });
+        });
+    }
+
     UID get_grid_range() const override {
         return UID(tile_buffer.get_range()[0], tile_buffer.get_range()[1]);
     }
 
     void run(uindex_t n_generations) override {
+        uindex_t target_i_generation = this->get_i_generation() + n_generations;
+
+        while (this->get_i_generation() < target_i_generation) {
+            tile_buffer = run_pass(tile_buffer, this->get_trans_func(), this->get_i_generation(),
+                                   target_i_generation);
+
+            this->inc_i_generation(
+                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+        }
+    }
+
+    /**
+     * \brief Compute generations until a reduction of the last pass satisfies a predicate.
+     *
+     * The reduction is computed by the last computing stage of the execution kernel, which writes
+     * the reduced value to a one-element buffer. Only this value is transferred back to the host,
+     * and it always describes the difference between the last two generations. See \ref
+     * StencilExecutor.run_until for details.
+     *
+     * \tparam Reduction The type of the reduction, see \ref MaxAbsDifference for the
+     * requirements.
+     * \tparam Predicate The type of the predicate, invocable with a `Reduction::Value`.
+     * \param reduction The reduction instance.
+     * \param predicate The predicate that decides whether the computation is finished.
+     * \param max_generations The maximal number of generations to compute.
+     * \return The reduced value of the last pass, or `reduction.identity()` if no pass has been
+     * computed.
+     */
+    template <typename Reduction, typename Predicate>
+    typename Reduction::Value run_until(Reduction reduction, Predicate predicate,
+                                        uindex_t max_generations) {
+        using Value = typename Reduction::Value;
+        uindex_t target_i_generation = this->get_i_generation() + max_generations;
+        Value value = reduction.identity();
+
+        while (this->get_i_generation() < target_i_generation) {
+            cl::sycl::range<1> result_range(1);
+            cl::sycl::buffer<Value, 1> result(result_range);
+            tile_buffer = run_pass(tile_buffer, this->get_trans_func(), this->get_i_generation(),
+                                   target_i_generation, reduction, result);
+            this->inc_i_generation(
+                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+
+            value = result.template get_access<cl::sycl::access::mode::read>()[0];
+            if (predicate(value)) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    /**
+     * \brief Compute the next generations of the grid with multiple transition function instances.
+     *
+     * Every instance in `trans_funcs` is a member of the ensemble and the next `n_generations`
+     * generations of the grid are computed for every member, starting from the current state of
+     * the grid. All members read the same internal tile buffer, so it is not copied. The passes of
+     * all members are submitted alternately without waiting for the host in between, which keeps
+     * the device busy.
+     *
+     * The grid, the generation index and the transition function instance of the executor are not
+     * altered. If the runtime analysis is enabled, the kernels and passes of all members are
+     * recorded in the executor's runtime sample, just like the passes of \ref run.
+     *
+     * \param trans_funcs The transition function instances of the ensemble members.
+     * \param n_generations The number of generations to calculate.
+     * \return The resulting grids of the members, in the same order as `trans_funcs`.
+     */
+    std::vector<cl::sycl::buffer<T, 2>> run_ensemble(std::vector<TransFunc> const &trans_funcs,
+                                                     uindex_t n_generations) {
+        std::vector<cl::sycl::buffer<T, 2>> member_buffers(trans_funcs.size(), tile_buffer);
+
+        uindex_t i_generation = this->get_i_generation();
+        uindex_t target_i_generation = i_generation + n_generations;
+
+        while (i_generation < target_i_generation) {
+            for (uindex_t i_member = 0; i_member < trans_funcs.size(); i_member++) {
+                member_buffers[i_member] =
+                    run_pass(member_buffers[i_member], trans_funcs[i_member], i_generation,
+                             target_i_generation);
+            }
+            i_generation += std::min(target_i_generation - i_generation, pipeline_length);
+        }
+
+        if (n_generations == 0) {
+            // Don't hand out the internal tile buffer.
+            for (cl::sycl::buffer<T, 2> &member_buffer : member_buffers) {
+                cl::sycl::buffer<T, 2> output_buffer(tile_buffer.get_range());
+                copy_buffer(tile_buffer, output_buffer);
+                member_buffer = output_buffer;
+            }
+        }
+
+        return member_buffers;
+    }
+
+  private:
+    /**
+     * \brief Submit all kernels of one pass over the grid.
+     *
+     * \param in_buffer The buffer to read the cells from.
+     * \param trans_func The transition function instance to use.
+     * \param i_generation The generation index of the input grid.
+     * \param target_i_generation The generation index to compute. At most `pipeline_length`
+     * generations are computed.
+     * \param reduction The reduction that the execution kernel computes, see \ref run_until.
+     * \param result The one-element buffer for the reduced value. Only used if a reduction other
+     * than \ref NoReduction is given.
+     * \return The output buffer of the pass.
+     */
+    template <typename Reduction = NoReduction>
+    cl::sycl::buffer<T, 2>
+    run_pass(cl::sycl::buffer<T, 2> in_buffer, TransFunc trans_func, uindex_t i_generation,
+             uindex_t target_i_generation, Reduction reduction = Reduction(),
+             std::optional<cl::sycl::buffer<typename Reduction::Value, 1>> result = std::nullopt) {
         using in_pipe = cl::sycl::pipe<class monotile_in_pipe, T>;
         using out_pipe = cl::sycl::pipe<class monotile_out_pipe, T>;
         using ExecutionKernelImpl =
             monotile::ExecutionKernel<TransFunc, T, stencil_radius, pipeline_length, tile_width,
                                       tile_height, in_pipe, out_pipe>;
 
+        this->check_pass_start(i_generation);
         cl::sycl::queue &queue = this->get_queue();
 
-        uindex_t target_i_generation = this->get_i_generation() + n_generations;
-        uindex_t grid_width = tile_buffer.get_range()[0];
-        uindex_t grid_height = tile_buffer.get_range()[1];
+        uindex_t grid_width = in_buffer.get_range()[0];
+        uindex_t grid_height = in_buffer.get_range()[1];
 
-        while (this->get_i_generation() < target_i_generation) {
-            cl::sycl::buffer<T, 2> out_buffer(tile_buffer.get_range());
-
-            queue.submit([&](cl::sycl::handler &cgh) {
-                auto ac = tile_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
-                T halo_value = this->get_halo_value();
-
-                cgh.single_task<class MonotileInputKernel>([=]() {
-                    [[intel::loop_coalesce(2)]] for (uindex_t c = 0; c < tile_width; c++) {
-                        for (uindex_t r = 0; r < tile_height; r++) {
-                            T value;
-                            if (c < grid_width && r < grid_height) {
-                                value = ac[c][r];
-                            } else {
-                                value = halo_value;
-                            }
-
-                            in_pipe::write(value);
+        cl::sycl::buffer<T, 2> out_buffer(in_buffer.get_range());
+
+        cl::sycl::event input_event = queue.submit([&](cl::sycl::handler &cgh) {
+            auto ac = in_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
+            T halo_value = this->get_halo_value();
+
+            cgh.single_task<class MonotileInputKernel>([=]() {
+                [[intel::loop_coalesce(2)]] for (uindex_t c = 0; c < tile_width; c++) {
+                    for (uindex_t r = 0; r < tile_height; r++) {
+                        T value;
+                        if (c < grid_width && r < grid_height) {
+                            value = ac[c][r];
+                        } else {
+                            value = halo_value;
                         }
+
+                        in_pipe::write(value);
                     }
-                });
+                }
             });
+        });
 
-            cl::sycl::event computation_event = queue.submit([&](cl::sycl::handler &cgh) {
-                cgh.single_task(ExecutionKernelImpl(
-                    this->get_trans_func(), this->get_i_generation(), target_i_generation,
-                    grid_width, grid_height, this->get_halo_value()));
-            });
+        cl::sycl::event computation_event = queue.submit([&](cl::sycl::handler &cgh) {
+            ExecutionKernelImpl kernel(trans_func, i_generation, target_i_generation, grid_width,
+                                       grid_height, this->get_halo_value());
+            if constexpr (std::is_same_v<Reduction, NoReduction>) {
+                cgh.single_task(kernel);
+            } else {
+                auto result_ac =
+                    result->template get_access<cl::sycl::access::mode::discard_write>(cgh);
+                cgh.single_task<class MonotileReductionKernel>(
+                    [=]() { result_ac[0] = kernel(reduction); });
+            }
+        });
 
-            queue.submit([&](cl::sycl::handler &cgh) {
-                auto ac =
-                    out_buffer.template get_access<cl::sycl::access::mode::discard_write>(cgh);
-                T halo_value = this->get_halo_value();
-
-                cgh.single_task<class MonotileInputKernel>([=]() {
-                    [[intel::loop_coalesce(2)]] for (uindex_t c = 0; c < tile_width; c++) {
-                        for (uindex_t r = 0; r < tile_height; r++) {
-                            T value = out_pipe::read();
-                            if (c < grid_width && r < grid_height) {
-                                ac[c][r] = value;
-                            }
+        cl::sycl::event output_event = queue.submit([&](cl::sycl::handler &cgh) {
+            auto ac = out_buffer.template get_access<cl::sycl::access::mode::discard_write>(cgh);
+            T halo_value = this->get_halo_value();
+
+            cgh.single_task<class MonotileOutputKernel>([=]() {
+                [[intel::loop_coalesce(2)]] for (uindex_t c = 0; c < tile_width; c++) {
+                    for (uindex_t r = 0; r < tile_height; r++) {
+                        T value = out_pipe::read();
+                        if (c < grid_width && r < grid_height) {
+                            ac[c][r] = value;
                         }
                     }
-                });
+                }
             });
+        });
 
-            tile_buffer = out_buffer;
+        if (this->is_runtime_analysis_enabled()) {
+            RuntimeSample &sample = this->get_runtime_sample();
+            double n_bytes = double(grid_width) * grid_height * sizeof(T);
+            sample.add_kernel(RuntimeSample::KernelCategory::INPUT, UID(0, 0), input_event,
+                              n_bytes);
+            sample.add_kernel(RuntimeSample::KernelCategory::EXECUTION, UID(0, 0),
+                              computation_event);
+            sample.add_kernel(RuntimeSample::KernelCategory::OUTPUT, UID(0, 0), output_event,
+                              n_bytes);
+            sample.add_pass(computation_event,
+                            double(grid_width) * grid_height *
+                                std::min(target_i_generation - i_generation, pipeline_length));
+        }
 
-            if (this->is_runtime_analysis_enabled()) {
-                this->get_runtime_sample().add_pass(computation_event);
-            }
+        return out_buffer;
+    }
 
-            this->inc_i_generation(
-                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+    static void copy_buffer(cl::sycl::buffer<T, 2> in_buffer, cl::sycl::buffer<T, 2> out_buffer) {
+        auto in_ac = in_buffer.template get_access<cl::sycl::access::mode::read>();
+        auto out_ac = out_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+        for (uindex_t c = 0; c < in_buffer.get_range()[0]; c++) {
+            for (uindex_t r = 0; r < in_buffer.get_range()[1]; r++) {
+                out_ac[c][r] = in_ac[c][r];
+            }
         }
     }
 
-  private:
     cl::sycl::buffer<T, 2> tile_buffer;
     UID grid_range;
 };
@@ -0,0 +1,383 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Index.hpp"
+#include "ResourceEstimate.hpp"
+#include "RuntimeSample.hpp"
+#include "monotile/ExecutionKernel.hpp"
+#include <cstdint>
+
+namespace stencil {
+/**
+ * \brief The comparison of a \ref PassPrediction with the runtime information of an executor.
+ */
+struct PerformanceComparison {
+    /**
+     * \brief The predicted runtime of a single pass, in seconds.
+     */
+    double predicted_pass_runtime;
+
+    /**
+     * \brief The mean measured runtime of a single pass, in seconds.
+     */
+    double measured_pass_runtime;
+
+    /**
+     * \brief The ratio of the predicted to the measured pass runtime.
+     *
+     * An efficiency of 1 means that the execution kernel processed one cell per clock cycle during
+     * the whole pass. Lower efficiencies are caused by stalls, for example due to insufficient
+     * memory bandwidth or gaps between kernel invocations.
+     */
+    double efficiency;
+
+    /**
+     * \brief The global memory bandwidth required to run at the predicted speed, in GB/s.
+     */
+    double predicted_bandwidth;
+
+    /**
+     * \brief The global memory bandwidth that was achieved on average, in GB/s.
+     */
+    double measured_bandwidth;
+};
+
+/**
+ * \brief The predicted costs of a single pass over the grid.
+ *
+ * The predictions assume that the execution kernel processes one cell per clock cycle, which is
+ * the goal of the kernel design, and that the I/O kernels keep up with it. They therefore describe
+ * the best case and are independent of the target device, apart from its clock frequency.
+ */
+struct PassPrediction {
+    /**
+     * \brief The number of execution kernel invocations.
+     */
+    uint64_t n_kernel_invocations;
+
+    /**
+     * \brief The number of clock cycles, i.e. loop iterations, of all execution kernel invocations.
+     */
+    uint64_t n_cycles;
+
+    /**
+     * \brief The number of cell updates that are part of the result, which is the number of grid
+     * cells times the number of computed generations.
+     */
+    uint64_t n_cell_updates;
+
+    /**
+     * \brief The number of cell updates that the pipeline stages perform, including the cells in
+     * the tile halos and the cells outside of the grid.
+     */
+    uint64_t n_computed_cell_updates;
+
+    /**
+     * \brief The number of bytes that are read from global memory.
+     */
+    uint64_t n_bytes_read;
+
+    /**
+     * \brief The number of bytes that are written to global memory.
+     */
+    uint64_t n_bytes_written;
+
+    /**
+     * \brief The fraction of computed cell updates that are not part of the result.
+     */
+    constexpr double get_redundancy() const {
+        return 1.0 - double(n_cell_updates) / double(n_computed_cell_updates);
+    }
+
+    /**
+     * \brief Predict the runtime of the pass, in seconds.
+     *
+     * \param clock_frequency The clock frequency of the execution kernel, in Hz.
+     */
+    constexpr double get_runtime(double clock_frequency) const {
+        return double(n_cycles) / clock_frequency;
+    }
+
+    /**
+     * \brief Compare the prediction with the passes recorded by an executor.
+     *
+     * All recorded passes are assumed to be passes with the predicted configuration. This is the
+     * case if the executor has always been run with the same grid range and with multiples of the
+     * pipeline length as the number of generations.
+     *
+     * \param sample The runtime sample of the executor, for example from \ref
+     * SingleQueueExecutor.get_runtime_sample.
+     * \param clock_frequency The clock frequency of the execution kernel, in Hz.
+     * \return The comparison of predicted and measured pass runtimes and bandwidths.
+     */
+    PerformanceComparison compare(RuntimeSample const &sample, double clock_frequency) const {
+        double predicted_pass_runtime = get_runtime(clock_frequency);
+        double measured_pass_runtime = sample.get_total_runtime() / sample.get_n_passes();
+        double n_bytes = double(n_bytes_read) + double(n_bytes_written);
+        return PerformanceComparison{predicted_pass_runtime, measured_pass_runtime,
+                                     predicted_pass_runtime / measured_pass_runtime,
+                                     n_bytes / predicted_pass_runtime / 1e9,
+                                     n_bytes / measured_pass_runtime / 1e9};
+    }
+};
+
+/**
+ * \brief Analytical performance model of the \ref tiling architecture.
+ *
+ * The model mirrors the loop bounds of \ref tiling::ExecutionKernel and the tile partitioning of
+ * \ref tiling::Grid. Activity tracking and domain masks may skip tiles and are not considered.
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam pipeline_length The number of hardware execution stages.
+ * \tparam tile_width The number of columns in a tile.
+ * \tparam tile_height The number of rows in a tile.
+ */
+template <typename T, uindex_t stencil_radius, uindex_t pipeline_length, uindex_t tile_width,
+          uindex_t tile_height>
+class TilingPerformanceModel {
+  public:
+    /**
+     * \brief The radius of the tile halo.
+     */
+    static constexpr uindex_t halo_radius = stencil_radius * pipeline_length;
+
+    /**
+     * \brief The width of a tile with its halo attached.
+     */
+    static constexpr uindex_t input_tile_width = 2 * halo_radius + tile_width;
+
+    /**
+     * \brief The height of a tile with its halo attached.
+     */
+    static constexpr uindex_t input_tile_height = 2 * halo_radius + tile_height;
+
+    /**
+     * \brief The number of loop iterations of a single execution kernel invocation.
+     */
+    static constexpr uint64_t n_cycles_per_tile = uint64_t(input_tile_width) * input_tile_height;
+
+    /**
+     * \brief The estimated on-chip resources of the execution kernel.
+     */
+    static constexpr ResourceEstimate resource_estimate =
+        ResourceEstimate::estimate<T, stencil_radius, pipeline_length>(input_tile_height);
+
+    /**
+     * \brief Get the number of tile columns that are needed to cover a grid width.
+     */
+    static constexpr uindex_t get_n_tile_columns(uindex_t grid_width) {
+        return grid_width / tile_width + (grid_width % tile_width != 0 ? 1 : 0);
+    }
+
+    /**
+     * \brief Get the number of tile rows that are needed to cover a grid height.
+     */
+    static constexpr uindex_t get_n_tile_rows(uindex_t grid_height) {
+        return grid_height / tile_height + (grid_height % tile_height != 0 ? 1 : 0);
+    }
+
+    /**
+     * \brief Predict the costs of a pass over a grid.
+     *
+     * \param grid_width The number of columns in the grid.
+     * \param grid_height The number of rows in the grid.
+     * \param n_generations The number of generations computed by the pass. Only the first
+     * `n_generations` stages of the pipeline are active.
+     * \return The predicted costs.
+     */
+    static constexpr PassPrediction predict_pass(uindex_t grid_width, uindex_t grid_height,
+                                                 uindex_t n_generations = pipeline_length) {
+        uint64_t n_tiles =
+            uint64_t(get_n_tile_columns(grid_width)) * get_n_tile_rows(grid_height);
+        uint64_t n_active_stages =
+            n_generations < pipeline_length ? n_generations : pipeline_length;
+        return PassPrediction{
+            n_tiles,
+            n_tiles * n_cycles_per_tile,
+            uint64_t(grid_width) * grid_height * n_active_stages,
+            n_tiles * n_cycles_per_tile * n_active_stages,
+            n_tiles * n_cycles_per_tile * sizeof(T),
+            n_tiles * tile_width * tile_height * sizeof(T),
+        };
+    }
+};
+
+/**
+ * \brief Analytical performance model of the \ref monotile.
+ *
+ * The model mirrors the loop bounds of \ref monotile::ExecutionKernel. Since the kernel always
+ * processes the whole tile, the number of cycles does not depend on the grid range.
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam pipeline_length The number of hardware execution stages.
+ * \tparam tile_width The number of columns in the tile and maximal number of columns in the grid.
+ * \tparam tile_height The number of rows in the tile and maximal number of rows in the grid.
+ */
+template <typename T, uindex_t stencil_radius, uindex_t pipeline_length, uindex_t tile_width,
+          uindex_t tile_height>
+class MonotilePerformanceModel {
+  public:
+    /**
+     * \brief The number of cells in the tile.
+     */
+    static constexpr uint64_t n_cells = uint64_t(tile_width) * tile_height;
+
+    /**
+     * \brief The number of cells that need to be fed into the pipeline before it produces correct
+     * values.
+     */
+    static constexpr uint64_t pipeline_latency =
+        uint64_t(pipeline_length) * stencil_radius * (tile_height + 1);
+
+    /**
+     * \brief The number of loop iterations of a single execution kernel invocation.
+     */
+    static constexpr uint64_t n_cycles_per_tile = pipeline_latency + n_cells;
+
+    /**
+     * \brief The estimated on-chip resources of the execution kernel.
+     */
+    static constexpr ResourceEstimate resource_estimate =
+        ResourceEstimate::estimate<T, stencil_radius, pipeline_length>(
+            tile_height, monotile::n_counter_bits_per_stage);
+
+    /**
+     * \brief Predict the costs of a pass over a grid.
+     *
+     * \param grid_width The number of columns in the grid.
+     * \param grid_height The number of rows in the grid.
+     * \param n_generations The number of generations computed by the pass. Only the first
+     * `n_generations` stages of the pipeline are active.
+     * \param n_grids The number of grids that are processed by one kernel invocation, as with the
+     * \ref MonotileBatchExecutor.
+     * \return The predicted costs.
+     */
+    static constexpr PassPrediction predict_pass(uindex_t grid_width, uindex_t grid_height,
+                                                 uindex_t n_generations = pipeline_length,
+                                                 uindex_t n_grids = 1) {
+        uint64_t n_active_stages =
+            n_generations < pipeline_length ? n_generations : pipeline_length;
+        uint64_t n_grid_cells = uint64_t(grid_width) * grid_height * n_grids;
+        return PassPrediction{
+            1,
+            pipeline_latency + n_grids * n_cells,
+            n_grid_cells * n_active_stages,
+            n_grids * n_cells * n_active_stages,
+            n_grid_cells * sizeof(T),
+            n_grid_cells * sizeof(T),
+        };
+    }
+};
+
+/**
+ * \brief Analytical performance model of the \ref SkewedExecutor.
+ *
+ * The model mirrors the loop bounds of \ref skewed::ExecutionKernel and the tile partitioning of
+ * \ref SkewedExecutor. Since the tiles exchange their boundary strips instead of recomputing a
+ * halo, every tile only adds `2 * stencil_radius` columns and rows to the computed cells, while the
+ * skew of the pipeline stages adds `pipeline_length * stencil_radius` columns and rows once per
+ * grid.
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam pipeline_length The number of hardware execution stages.
+ * \tparam tile_width The number of columns in a tile.
+ * \tparam tile_height The number of rows in a tile.
+ */
+template <typename T, uindex_t stencil_radius, uindex_t pipeline_length, uindex_t tile_width,
+          uindex_t tile_height>
+class SkewedPerformanceModel {
+  public:
+    /**
+     * \brief The number of cells the output tiles are shifted to the north and west.
+     */
+    static constexpr uindex_t skew = stencil_radius * pipeline_length;
+
+    /**
+     * \brief The width of the western and eastern strips and the height of the northern and
+     * southern strips of a tile.
+     */
+    static constexpr uindex_t strip_width = 2 * stencil_radius;
+
+    /**
+     * \brief The number of bytes that are transferred for a strip cell, which contains the inputs
+     * of all pipeline stages except the first one.
+     */
+    static constexpr uindex_t strip_cell_size =
+        pipeline_length > 1 ? (pipeline_length - 1) * sizeof(T) : 0;
+
+    /**
+     * \brief The estimated on-chip resources of the execution kernel.
+     */
+    static constexpr ResourceEstimate resource_estimate =
+        ResourceEstimate::estimate<T, stencil_radius, pipeline_length>(tile_height + strip_width);
+
+    /**
+     * \brief Get the number of tile columns that are needed to cover a grid width.
+     */
+    static constexpr uindex_t get_n_tile_columns(uindex_t grid_width) {
+        return (grid_width + skew) / tile_width + ((grid_width + skew) % tile_width != 0 ? 1 : 0);
+    }
+
+    /**
+     * \brief Get the number of tile rows that are needed to cover a grid height.
+     */
+    static constexpr uindex_t get_n_tile_rows(uindex_t grid_height) {
+        return (grid_height + skew) / tile_height +
+               ((grid_height + skew) % tile_height != 0 ? 1 : 0);
+    }
+
+    /**
+     * \brief Predict the costs of a pass over a grid.
+     *
+     * The number of bytes that are written for the strips is approximated with the number of bytes
+     * that are read for them.
+     *
+     * \param grid_width The number of columns in the grid.
+     * \param grid_height The number of rows in the grid.
+     * \param n_generations The number of generations computed by the pass. Only the first
+     * `n_generations` stages of the pipeline are active.
+     * \return The predicted costs.
+     */
+    static constexpr PassPrediction predict_pass(uindex_t grid_width, uindex_t grid_height,
+                                                 uindex_t n_generations = pipeline_length) {
+        uint64_t n_tile_columns = get_n_tile_columns(grid_width);
+        uint64_t n_tile_rows = get_n_tile_rows(grid_height);
+        uint64_t n_active_stages =
+            n_generations < pipeline_length ? n_generations : pipeline_length;
+
+        // The last tile column and row are cut off at the grid border.
+        uint64_t n_cycles = (uint64_t(grid_width) + skew + n_tile_columns * strip_width) *
+                            (uint64_t(grid_height) + skew + n_tile_rows * strip_width);
+        uint64_t n_strip_cells =
+            n_cycles - (uint64_t(grid_width) + skew) * (uint64_t(grid_height) + skew);
+        return PassPrediction{
+            n_tile_columns * n_tile_rows,
+            n_cycles,
+            uint64_t(grid_width) * grid_height * n_active_stages,
+            n_cycles * n_active_stages,
+            n_cycles * sizeof(T) + n_strip_cells * strip_cell_size,
+            uint64_t(grid_width) * grid_height * sizeof(T) + n_strip_cells * strip_cell_size,
+        };
+    }
+};
+} // namespace stencil
@@ -0,0 +1,96 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+
+namespace stencil {
+/**
+ * \brief A reduction that computes the maximal absolute difference between the cells of two
+ * generations.
+ *
+ * This is the usual convergence criterion of iterative solvers and an example of the reductions
+ * that are accepted by \ref StencilExecutor.run_until and \ref MonotileExecutor.run_until. A
+ * reduction class has to be copyable to the device and has to provide:
+ *
+ * * A type `Value` of the reduced value, which is transferred back to the host.
+ * * A method `Value identity() const` that returns the neutral element of `combine`.
+ * * A method `Value map(T const &previous, T const &current) const` that maps the value of a cell
+ * in the second-to-last and in the last computed generation to a value.
+ * * A method `Value combine(Value a, Value b) const` that is associative and commutative, since
+ * the cells are reduced in an unspecified order.
+ *
+ * The reduction is computed by the last stage of the execution kernel while it updates the cells,
+ * so `map` and `combine` are applied once per cell in the kernel's main loop and should be cheap.
+ *
+ * \tparam T The cell type. It has to support subtraction and comparison, like `float` or `double`.
+ */
+template <typename T> class MaxAbsDifference {
+  public:
+    /**
+     * \brief The type of the reduced value.
+     */
+    using Value = T;
+
+    /**
+     * \brief The neutral element of \ref MaxAbsDifference.combine.
+     */
+    Value identity() const { return Value(0); }
+
+    /**
+     * \brief Get the absolute difference of a cell in two generations.
+     */
+    Value map(T const &previous, T const &current) const {
+        return current > previous ? current - previous : previous - current;
+    }
+
+    /**
+     * \brief Get the maximum of two values.
+     */
+    Value combine(Value a, Value b) const { return a > b ? a : b; }
+};
+
+/**
+ * \brief A reduction that does nothing.
+ *
+ * It is used by the execution kernels when no reduction is requested. Since all of its methods
+ * return constants, it does not occupy any resources.
+ */
+class NoReduction {
+  public:
+    /**
+     * \brief The type of the reduced value.
+     */
+    using Value = bool;
+
+    /**
+     * \brief Return `false`.
+     */
+    Value identity() const { return false; }
+
+    /**
+     * \brief Return `false`.
+     */
+    template <typename T> Value map(T const &previous, T const &current) const { return false; }
+
+    /**
+     * \brief Return `false`.
+     */
+    Value combine(Value a, Value b) const { return false; }
+};
+} // namespace stencil
@@ -0,0 +1,148 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Helpers.hpp"
+#include "Index.hpp"
+#include <cstdint>
+
+namespace stencil {
+/**
+ * \brief Resource limits that an execution kernel configuration has to meet.
+ *
+ * A budget is checked with \ref ResourceEstimate.fits, which can be used in a `static_assert` to
+ * prune configurations at compile time.
+ */
+struct ResourceBudget {
+    /**
+     * \brief The maximal number of on-chip memory blocks of the stencil cache.
+     */
+    uint64_t n_memory_blocks;
+
+    /**
+     * \brief The maximal number of register bits of all pipeline stages.
+     */
+    uint64_t n_register_bits;
+};
+
+/**
+ * \brief A compile-time estimate of the on-chip resources of an execution kernel.
+ *
+ * Both execution kernels use the same structures: A cache with two halves of `cache_height` rows,
+ * `next_power_of_two(pipeline_length)` stage slots and `stencil_diameter - 1` cells per slot,
+ * partitioned into `2 * next_power_of_two(pipeline_length)` banks, and a register window of
+ * `stencil_diameter * stencil_diameter` cells per stage. The estimate covers these structures
+ * only; logic and DSP usage depend on the transition function and are not estimated.
+ *
+ * The number of memory blocks assumes 20 kbit blocks in a 512x40 bit configuration, as found in
+ * Intel Stratix 10 and Agilex FPGAs. The compiler may choose other configurations or implement
+ * small banks in registers, so the estimate is an upper bound for the typical case.
+ */
+struct ResourceEstimate {
+    /**
+     * \brief The width of a memory block in bits.
+     */
+    static constexpr uint64_t memory_block_width = 40;
+
+    /**
+     * \brief The depth of a memory block in words.
+     */
+    static constexpr uint64_t memory_block_depth = 512;
+
+    /**
+     * \brief The number of bits of the declared cache, including the padding banks.
+     */
+    uint64_t n_cache_bits;
+
+    /**
+     * \brief The number of cache bits that are actually accessed by the pipeline stages.
+     */
+    uint64_t n_used_cache_bits;
+
+    /**
+     * \brief The number of declared cache banks.
+     */
+    uint64_t n_cache_banks;
+
+    /**
+     * \brief The number of cache banks that only exist due to the power-of-two padding.
+     *
+     * The compiler should optimize these banks away, but they indicate that a pipeline length
+     * that is a power of two would use the cache more efficiently.
+     */
+    uint64_t n_wasted_cache_banks;
+
+    /**
+     * \brief The estimated number of memory blocks of the used cache banks.
+     */
+    uint64_t n_memory_blocks;
+
+    /**
+     * \brief The number of register bits of a single pipeline stage.
+     */
+    uint64_t n_register_bits_per_stage;
+
+    /**
+     * \brief The number of register bits of all pipeline stages.
+     */
+    uint64_t n_register_bits;
+
+    /**
+     * \brief Check whether the estimate meets a resource budget.
+     */
+    constexpr bool fits(ResourceBudget budget) const {
+        return n_memory_blocks <= budget.n_memory_blocks &&
+               n_register_bits <= budget.n_register_bits;
+    }
+
+    /**
+     * \brief Estimate the resources of an execution kernel.
+     *
+     * \tparam T The cell type.
+     * \tparam stencil_radius The radius of the stencil buffer.
+     * \tparam pipeline_length The number of pipeline stages.
+     * \param cache_height The number of rows in a half of the cache.
+     * \param n_counter_bits_per_stage The number of bits of additional per-stage registers, like
+     * column and row counters.
+     */
+    template <typename T, uindex_t stencil_radius, uindex_t pipeline_length>
+    static constexpr ResourceEstimate estimate(uint64_t cache_height,
+                                               uint64_t n_counter_bits_per_stage = 0) {
+        constexpr uint64_t stencil_diameter = 2 * stencil_radius + 1;
+        constexpr uint64_t cell_bits = 8 * sizeof(T);
+        constexpr uint64_t n_stage_slots = next_power_of_two(pipeline_length);
+
+        uint64_t bank_width = (stencil_diameter - 1) * cell_bits;
+        uint64_t n_blocks_per_bank = ((bank_width + memory_block_width - 1) / memory_block_width) *
+                                     ((cache_height + memory_block_depth - 1) / memory_block_depth);
+        uint64_t n_register_bits_per_stage =
+            stencil_diameter * stencil_diameter * cell_bits + n_counter_bits_per_stage;
+
+        return ResourceEstimate{
+            2 * cache_height * n_stage_slots * bank_width,
+            2 * cache_height * pipeline_length * bank_width,
+            2 * n_stage_slots,
+            2 * (n_stage_slots - pipeline_length),
+            2 * pipeline_length * n_blocks_per_bank,
+            n_register_bits_per_stage,
+            pipeline_length * n_register_bits_per_stage,
+        };
+    }
+};
+} // namespace stencil
@@ -18,20 +18,82 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #pragma once
+#include "GenericID.hpp"
 #include "Index.hpp"
 #include <CL/sycl/buffer.hpp>
 #include <CL/sycl/event.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
 
 namespace stencil {
 /**
  * \brief Collection of runtime performance information for a \ref SingleQueueExecutor.
+ *
+ * Apart from the makespan of every pass, the executors also record the events of every kernel they
+ * submit, tagged with the category of the kernel, the index of the pass and the id of the tile.
+ * These kernel records can be used to find out whether the input, the execution or the output is
+ * the bottleneck.
+ *
+ * The executors never reset their sample on their own: The passes and kernels of all runs are
+ * accumulated, including those of ensemble runs, until \ref RuntimeSample.clear is called. Since
+ * every kernel record holds on to its event, long-running applications that enable runtime analysis
+ * should clear the sample after evaluating it.
  */
 class RuntimeSample {
   public:
+    /**
+     * \brief The category of a submitted kernel.
+     */
+    enum class KernelCategory {
+        INPUT,
+        EXECUTION,
+        OUTPUT,
+    };
+
+    /**
+     * \brief The runtime information of a single kernel invocation.
+     */
+    struct KernelRecord {
+        /**
+         * \brief The category of the kernel.
+         */
+        KernelCategory category;
+
+        /**
+         * \brief The index of the pass the kernel belongs to.
+         */
+        uindex_t i_pass;
+
+        /**
+         * \brief The id of the tile the kernel has worked on.
+         */
+        UID tile_id;
+
+        /**
+         * \brief The starting timestamp of the kernel, in seconds.
+         */
+        double start;
+
+        /**
+         * \brief The ending timestamp of the kernel, in seconds.
+         */
+        double end;
+
+        /**
+         * \brief The number of bytes the kernel has read from or written to global memory.
+         */
+        double n_bytes;
+    };
+
     /**
      * \brief Prepare the collection of SYCL events.
      */
-    RuntimeSample() : makespan(0.0), n_passes(0.0) {}
+    RuntimeSample() : makespan(0.0), n_passes(0.0), n_cell_updates(0.0), kernels() {}
 
     /**
      * \brief Retrieve the starting timestamp of the event, in seconds.
@@ -67,34 +129,272 @@ class RuntimeSample {
 
     /**
      * \brief Add the runtime/makespan of a single pass over the grid to the database.
+     *
+     * \param pass_runtime The makespan of the pass, in seconds.
+     * \param n_cell_updates The number of cell updates computed by the pass, which is the number of
+     * cells in the grid times the number of computed generations.
      */
-    void add_pass(double pass_runtime) {
+    void add_pass(double pass_runtime, double n_cell_updates = 0.0) {
         makespan += pass_runtime;
         n_passes += 1.0;
+        this->n_cell_updates += n_cell_updates;
     }
 
     /**
      * \brief Add the event of a single pass over the grid to the database.
+     *
+     * \param event The event of the kernel that has executed the pass.
+     * \param n_cell_updates The number of cell updates computed by the pass, which is the number of
+     * cells in the grid times the number of computed generations.
+     */
+    void add_pass(cl::sycl::event event, double n_cell_updates = 0.0) {
+        add_pass(runtime_of_event(event), n_cell_updates);
+    }
+
+    /**
+     * \brief Add the event of a kernel to the database.
+     *
+     * The kernel is assigned to the pass that is recorded next with \ref RuntimeSample.add_pass.
+     * The runtime information of the event is only retrieved when it is queried, so recording the
+     * event does not wait for the kernel.
+     *
+     * \param category The category of the kernel.
+     * \param tile_id The id of the tile the kernel works on.
+     * \param event The event of the kernel.
+     * \param n_bytes The number of bytes the kernel reads from or writes to global memory.
+     */
+    void add_kernel(KernelCategory category, UID tile_id, cl::sycl::event event,
+                    double n_bytes = 0.0) {
+        kernels.push_back(PendingKernel{category, uindex_t(n_passes), tile_id, event, n_bytes});
+    }
+
+    /**
+     * \brief Remove all recorded passes and kernels from the database.
+     *
+     * The sample is in the same state as a newly constructed one afterwards.
+     */
+    void clear() {
+        makespan = 0.0;
+        n_passes = 0.0;
+        n_cell_updates = 0.0;
+        kernels.clear();
+    }
+
+    /**
+     * \brief Get the records of all kernels that have been added to the database.
+     *
+     * This waits for all recorded kernels to finish.
+     */
+    std::vector<KernelRecord> get_kernel_records() const {
+        std::vector<KernelRecord> records;
+        records.reserve(kernels.size());
+        for (PendingKernel const &kernel : kernels) {
+            records.push_back(KernelRecord{kernel.category, kernel.i_pass, kernel.tile_id,
+                                           start_of_event(kernel.event),
+                                           end_of_event(kernel.event), kernel.n_bytes});
+        }
+        return records;
+    }
+
+    /**
+     * \brief Get the number of recorded kernels of a category.
+     */
+    uindex_t get_n_kernels(KernelCategory category) const {
+        return std::count_if(kernels.begin(), kernels.end(), [&](PendingKernel const &kernel) {
+            return kernel.category == category;
+        });
+    }
+
+    /**
+     * \brief Get the sum of the runtimes of all recorded kernels of a category, in seconds.
+     *
+     * Since kernels of different categories run concurrently, the sums of all categories may exceed
+     * the total runtime.
+     */
+    double get_total_kernel_runtime(KernelCategory category) const {
+        double total_runtime = 0.0;
+        for (double runtime : get_kernel_runtimes(category)) {
+            total_runtime += runtime;
+        }
+        return total_runtime;
+    }
+
+    /**
+     * \brief Get a percentile of the runtimes of the recorded kernels of a category, in seconds.
+     *
+     * The percentile is computed with the nearest-rank method. For example, a percentile of 0.5
+     * returns the median runtime and a percentile of 1.0 returns the maximal runtime.
+     *
+     * \param category The category of the kernels.
+     * \param percentile The percentile, in the range [0, 1].
+     * \return The percentile of the runtimes, or 0 if no kernel of the category has been recorded.
+     * \throws std::invalid_argument Thrown if the percentile is not in the range [0, 1].
+     */
+    double get_kernel_runtime_percentile(KernelCategory category, double percentile) const {
+        if (percentile < 0.0 || percentile > 1.0) {
+            throw std::invalid_argument("The percentile must be in the range [0, 1]");
+        }
+        std::vector<double> runtimes = get_kernel_runtimes(category);
+        if (runtimes.empty()) {
+            return 0.0;
+        }
+        std::sort(runtimes.begin(), runtimes.end());
+
+        uindex_t rank = uindex_t(std::ceil(percentile * runtimes.size()));
+        return runtimes[std::max<uindex_t>(rank, 1) - 1];
+    }
+
+    /**
+     * \brief Get the number of bytes that the recorded kernels of a category have transferred.
+     */
+    double get_n_bytes(KernelCategory category) const {
+        double n_bytes = 0.0;
+        for (PendingKernel const &kernel : kernels) {
+            if (kernel.category == category) {
+                n_bytes += kernel.n_bytes;
+            }
+        }
+        return n_bytes;
+    }
+
+    /**
+     * \brief Calculate the achieved global memory bandwidth of all passes, in GB/s.
+     *
+     * This is the number of bytes transferred by all recorded kernels divided by the total
+     * runtime.
      */
-    void add_pass(cl::sycl::event event) { add_pass(runtime_of_event(event)); }
+    double get_bandwidth() const {
+        double n_bytes = get_n_bytes(KernelCategory::INPUT) +
+                         get_n_bytes(KernelCategory::EXECUTION) +
+                         get_n_bytes(KernelCategory::OUTPUT);
+        return n_bytes / makespan / 1e9;
+    }
+
+    /**
+     * \brief Calculate the achieved throughput of all passes, in cell updates per second.
+     */
+    double get_cell_throughput() const { return n_cell_updates / makespan; }
+
+    /**
+     * \brief Get the number of recorded passes.
+     */
+    uindex_t get_n_passes() const { return uindex_t(n_passes); }
 
     /**
      * \brief Get the makespan of all grid passes.
      *
      * \return The makespan in seconds it took to execute all passes.
      */
-    double get_total_runtime() { return makespan; }
+    double get_total_runtime() const { return makespan; }
 
     /**
      * \brief Calculate the mean execution speed in passes per second.
      *
      * \return The mean execution speed in passes per second.
      */
-    double get_mean_speed() { return makespan / n_passes; }
+    double get_mean_speed() const { return n_passes / makespan; }
+
+    /**
+     * \brief Write the recorded kernels as a Chrome trace-event JSON document.
+     *
+     * The document can be loaded into `chrome://tracing` or the Perfetto UI. Every kernel is an
+     * event on its own track, named after its category and its index among the kernels of the same
+     * category that were submitted for the same tile and pass. For the tiled executors, these are
+     * the five input kernels, the execution kernel and the three output kernels. The event
+     * arguments contain the pass index, the tile id and the number of transferred bytes. All
+     * timestamps are relative to the start of the earliest kernel.
+     *
+     * This waits for all recorded kernels to finish.
+     *
+     * \param out The stream to write the document to.
+     */
+    void write_chrome_trace(std::ostream &out) const {
+        std::vector<KernelRecord> records = get_kernel_records();
+
+        double trace_start = 0.0;
+        if (!records.empty()) {
+            trace_start = records[0].start;
+            for (KernelRecord const &record : records) {
+                trace_start = std::min(trace_start, record.start);
+            }
+        }
+
+        // Assign every kernel to a track, based on its index among the kernels of the same category
+        // that were submitted for the same tile and pass.
+        std::map<std::tuple<KernelCategory, uindex_t, uindex_t, uindex_t>, uindex_t> n_submitted;
+        std::map<std::tuple<KernelCategory, uindex_t>, uindex_t> track_ids;
+        std::vector<uindex_t> record_track_ids;
+        record_track_ids.reserve(records.size());
+        for (KernelRecord const &record : records) {
+            uindex_t i_kernel = n_submitted[std::make_tuple(record.category, record.i_pass,
+                                                            record.tile_id.c, record.tile_id.r)]++;
+            auto track = track_ids.emplace(std::make_tuple(record.category, i_kernel),
+                                           track_ids.size());
+            record_track_ids.push_back(track.first->second);
+        }
+
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first_event = true;
+        for (auto const &track : track_ids) {
+            out << (first_event ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\","
+                << "\"pid\":0,\"tid\":" << track.second << ",\"args\":{\"name\":\""
+                << get_category_name(std::get<0>(track.first)) << " "
+                << std::get<1>(track.first) << "\"}}";
+            out << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":0,\"tid\":"
+                << track.second << ",\"args\":{\"sort_index\":" << track.second << "}}";
+            first_event = false;
+        }
+        for (uindex_t i = 0; i < records.size(); i++) {
+            KernelRecord const &record = records[i];
+            out << (first_event ? "" : ",") << "\n{\"name\":\""
+                << get_category_name(record.category) << " (" << record.tile_id.c << ", "
+                << record.tile_id.r << ")\",\"cat\":\"" << get_category_name(record.category)
+                << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << record_track_ids[i]
+                << ",\"ts\":" << (record.start - trace_start) * 1e6
+                << ",\"dur\":" << (record.end - record.start) * 1e6 << ",\"args\":{\"pass\":"
+                << record.i_pass << ",\"tile_c\":" << record.tile_id.c
+                << ",\"tile_r\":" << record.tile_id.r << ",\"bytes\":" << record.n_bytes
+                << "}}";
+            first_event = false;
+        }
+        out << "\n]}\n";
+    }
 
   private:
     static constexpr double timesteps_per_second = 1000000000.0;
 
-    double makespan, n_passes;
+    static char const *get_category_name(KernelCategory category) {
+        switch (category) {
+        case KernelCategory::INPUT:
+            return "input";
+        case KernelCategory::EXECUTION:
+            return "execution";
+        case KernelCategory::OUTPUT:
+            return "output";
+        default:
+            return "unknown";
+        }
+    }
+
+    struct PendingKernel {
+        KernelCategory category;
+        uindex_t i_pass;
+        UID tile_id;
+        cl::sycl::event event;
+        double n_bytes;
+    };
+
+    std::vector<double> get_kernel_runtimes(KernelCategory category) const {
+        std::vector<double> runtimes;
+        for (PendingKernel const &kernel : kernels) {
+            if (kernel.category == category) {
+                runtimes.push_back(runtime_of_event(kernel.event));
+            }
+        }
+        return runtimes;
+    }
+
+    double makespan, n_passes, n_cell_updates;
+    std::vector<PendingKernel> kernels;
 };
 } // namespace stencil
\ No newline at end of file
@@ -21,7 +21,10 @@
 #include "AbstractExecutor.hpp"
 #include "RuntimeSample.hpp"
 #include <CL/sycl/INTEL/fpga_extensions.hpp>
+#include <fstream>
 #include <optional>
+#include <stdexcept>
+#include <string>
 
 namespace stencil {
 /**
@@ -167,10 +170,34 @@ class SingleQueueExecutor : public AbstractExecutor<T, stencil_radius, TransFunc
     /**
      * \brief Return a reference to the runtime information struct.
      *
+     * The sample accumulates the information of all runs of the executor. Use
+     * \ref RuntimeSample.clear to start a new measurement.
+     *
      * \return The collected runtime information.
      */
     RuntimeSample &get_runtime_sample() { return runtime_sample; }
 
+    /**
+     * \brief Write the timeline of all recorded kernels to a Chrome trace-event JSON file.
+     *
+     * The file can be loaded into `chrome://tracing` or the Perfetto UI to inspect how the
+     * submitted kernels overlap. The kernels are only recorded if runtime analysis is enabled. See
+     * \ref RuntimeSample.write_chrome_trace for the layout of the trace.
+     *
+     * \param path The path of the trace file.
+     * \throws std::runtime_error Thrown if the file could not be written.
+     */
+    void write_trace(std::string path) {
+        std::ofstream trace_file(path);
+        if (!trace_file) {
+            throw std::runtime_error("Could not open the trace file " + path);
+        }
+        runtime_sample.write_chrome_trace(trace_file);
+        if (!trace_file) {
+            throw std::runtime_error("Could not write the trace file " + path);
+        }
+    }
+
   private:
     static cl::sycl::property_list get_queue_properties(bool runtime_analysis) {
         cl::sycl::property_list properties;
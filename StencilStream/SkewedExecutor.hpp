@@ -0,0 +1,348 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "PerformanceModel.hpp"
+#include "SingleQueueExecutor.hpp"
+#include "skewed/ExecutionKernel.hpp"
+#include <limits>
+#include <vector>
+
+namespace stencil {
+/**
+ * \brief An executor that partitions the grid into skewed tiles which exchange their boundary
+ * strips instead of recomputing a halo.
+ *
+ * The \ref StencilExecutor recomputes a halo of `stencil_radius * pipeline_length` cells on every
+ * side of every tile, which becomes a considerable overhead for long pipelines. This executor uses
+ * the \ref skewed::ExecutionKernel instead, whose pipeline stages work on windows that are shifted
+ * by `stencil_radius` cells per stage. The intermediate generations at the eastern and southern
+ * borders of a tile are stored in strip buffers and read by the tiles to the east and south, so
+ * that every intermediate cell is computed once and every tile only adds `2 * stencil_radius`
+ * columns and rows of overhead. The output tiles are shifted by `stencil_radius * pipeline_length`
+ * cells to the north and west, and the tiles at the eastern and southern borders of the grid are
+ * cut off at the grid border. See \ref SkewedPerformanceModel for the resulting costs.
+ *
+ * Since the tiles depend on each other, they are processed one after another in column-major
+ * order, and the grid is stored in a single buffer.
+ *
+ * \tparam T The cell type.
+ * \tparam stencil_radius The radius of the stencil buffer supplied to the transition function.
+ * \tparam TransFunc The type of the transition function.
+ * \tparam pipeline_length The number of hardware execution stages per kernel. Must be at least 1.
+ * Defaults to 1.
+ * \tparam tile_width The number of columns in a tile. Must be at least `2 * stencil_radius`.
+ * Defaults to 1024.
+ * \tparam tile_height The number of rows in a tile. Must be at least `2 * stencil_radius`.
+ * Defaults to 1024.
+ */
+template <typename T, uindex_t stencil_radius, typename TransFunc, uindex_t pipeline_length = 1,
+          uindex_t tile_width = 1024, uindex_t tile_height = 1024>
+class SkewedExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc> {
+  public:
+    /**
+     * \brief Shorthand for the parent class.
+     */
+    using Parent = SingleQueueExecutor<T, stencil_radius, TransFunc>;
+
+    /**
+     * \brief The analytical performance model of this executor's configuration.
+     */
+    using PerformanceModel =
+        SkewedPerformanceModel<T, stencil_radius, pipeline_length, tile_width, tile_height>;
+
+    /**
+     * \brief The number of cells the output tiles are shifted to the north and west.
+     */
+    static constexpr uindex_t skew = PerformanceModel::skew;
+
+    /**
+     * \brief The width of the western and eastern strips and the height of the northern and
+     * southern strips of a tile.
+     */
+    static constexpr uindex_t strip_width = PerformanceModel::strip_width;
+
+    /**
+     * \brief Create a new executor.
+     *
+     * \param halo_value The value of cells in the grid halo.
+     * \param trans_func An instance of the transition function type.
+     */
+    SkewedExecutor(T halo_value, TransFunc trans_func)
+        : Parent(halo_value, trans_func), grid_buffer(cl::sycl::range<2>(1, 1)) {
+        auto ac = grid_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+        ac[0][0] = halo_value;
+    }
+
+    /**
+     * \brief Set the internal state of the grid.
+     *
+     * This will copy the contents of the buffer to an internal representation. The buffer may be
+     * used for other purposes later. It does not reset the generation index. The range of the
+     * input buffer will be used as the new grid range.
+     *
+     * \param input_buffer The source buffer of the new grid state.
+     */
+    void set_input(cl::sycl::buffer<T, 2> input_buffer) override {
+        grid_buffer = cl::sycl::buffer<T, 2>(input_buffer.get_range());
+        copy_buffer(input_buffer, grid_buffer);
+    }
+
+    void copy_output(cl::sycl::buffer<T, 2> output_buffer) override {
+        if (output_buffer.get_range() != grid_buffer.get_range()) {
+            throw std::range_error("The output buffer is not the same size as the grid");
+        }
+        copy_buffer(grid_buffer, output_buffer);
+    }
+
+    UID get_grid_range() const override {
+        return UID(grid_buffer.get_range()[0], grid_buffer.get_range()[1]);
+    }
+
+    void run(uindex_t n_generations) override {
+        uindex_t target_i_generation = this->get_i_generation() + n_generations;
+
+        while (this->get_i_generation() < target_i_generation) {
+            grid_buffer = run_pass(grid_buffer, this->get_i_generation(), target_i_generation);
+
+            this->inc_i_generation(
+                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+        }
+    }
+
+  private:
+    using in_pipe = cl::sycl::pipe<class skewed_in_pipe, T>;
+    using out_pipe = cl::sycl::pipe<class skewed_out_pipe, T>;
+    using StripImpl = skewed::Strip<T, pipeline_length>;
+    using strip_in_pipe = cl::sycl::pipe<class skewed_strip_in_pipe, StripImpl>;
+    using strip_out_pipe = cl::sycl::pipe<class skewed_strip_out_pipe, StripImpl>;
+    using ExecutionKernelImpl =
+        skewed::ExecutionKernel<TransFunc, T, stencil_radius, pipeline_length, tile_width,
+                                tile_height, in_pipe, out_pipe, strip_in_pipe, strip_out_pipe>;
+
+    /**
+     * \brief Submit all kernels of one pass over the grid.
+     *
+     * The strips of a tile column are read from one of the two column strip buffers and written to
+     * the other one, and the same holds for the row strip buffers and the tiles of a column. This
+     * way, the strip input and output kernels of a tile never access the same buffer.
+     *
+     * \param in_buffer The buffer to read the cells from.
+     * \param i_generation The generation index of the input grid.
+     * \param target_i_generation The generation index to compute. At most `pipeline_length`
+     * generations are computed.
+     * \return The output buffer of the pass.
+     */
+    cl::sycl::buffer<T, 2> run_pass(cl::sycl::buffer<T, 2> in_buffer, uindex_t i_generation,
+                                    uindex_t target_i_generation) {
+        this->check_pass_start(i_generation);
+        cl::sycl::queue &queue = this->get_queue();
+
+        uindex_t grid_width = in_buffer.get_range()[0];
+        uindex_t grid_height = in_buffer.get_range()[1];
+        uindex_t n_tile_columns = PerformanceModel::get_n_tile_columns(grid_width);
+        uindex_t n_tile_rows = PerformanceModel::get_n_tile_rows(grid_height);
+
+        cl::sycl::buffer<T, 2> out_buffer(in_buffer.get_range());
+        cl::sycl::range<2> column_strip_range(strip_width,
+                                              n_tile_rows * tile_height + strip_width);
+        cl::sycl::range<2> row_strip_range(tile_width, strip_width);
+        cl::sycl::buffer<StripImpl, 2> column_strips[2] = {
+            cl::sycl::buffer<StripImpl, 2>(column_strip_range),
+            cl::sycl::buffer<StripImpl, 2>(column_strip_range)};
+        cl::sycl::buffer<StripImpl, 2> row_strips[2] = {
+            cl::sycl::buffer<StripImpl, 2>(row_strip_range),
+            cl::sycl::buffer<StripImpl, 2>(row_strip_range)};
+
+        std::vector<cl::sycl::event> events;
+        events.reserve(n_tile_columns * n_tile_rows);
+
+        for (uindex_t c = 0; c < n_tile_columns; c++) {
+            for (uindex_t r = 0; r < n_tile_rows; r++) {
+                uindex_t tile_c_offset = c * tile_width;
+                uindex_t tile_r_offset = r * tile_height;
+                uindex_t n_columns = std::min(tile_width, grid_width + skew - tile_c_offset);
+                uindex_t n_rows = std::min(tile_height, grid_height + skew - tile_r_offset);
+                uindex_t n_input_rows = n_rows + strip_width;
+                uindex_t n_input_cells = (n_columns + strip_width) * n_input_rows;
+                T halo_value = this->get_halo_value();
+
+                cl::sycl::event input_event = queue.submit([&](cl::sycl::handler &cgh) {
+                    auto ac = in_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
+
+                    cgh.single_task<class SkewedInputKernel>([=]() {
+                        index_t c_offset = index_t(tile_c_offset) - index_t(strip_width);
+                        index_t r_offset = index_t(tile_r_offset) - index_t(strip_width);
+                        [[intel::loop_coalesce(2)]] for (uindex_t ic = 0;
+                                                         ic < n_columns + strip_width; ic++) {
+                            for (uindex_t ir = 0; ir < n_input_rows; ir++) {
+                                index_t grid_c = c_offset + index_t(ic);
+                                index_t grid_r = r_offset + index_t(ir);
+                                T value;
+                                if (grid_c >= 0 && grid_r >= 0 && grid_c < grid_width &&
+                                    grid_r < grid_height) {
+                                    value = ac[grid_c][grid_r];
+                                } else {
+                                    value = halo_value;
+                                }
+                                in_pipe::write(value);
+                            }
+                        }
+                    });
+                });
+
+                cl::sycl::event strip_input_event;
+                if constexpr (pipeline_length > 1) {
+                    strip_input_event = queue.submit([&](cl::sycl::handler &cgh) {
+                        auto column_ac =
+                            column_strips[c % 2]
+                                .template get_access<cl::sycl::access::mode::read>(cgh);
+                        auto row_ac =
+                            row_strips[r % 2].template get_access<cl::sycl::access::mode::read>(
+                                cgh);
+
+                        // Iterate in the order of the execution kernel to find the strips.
+                        cgh.single_task<class SkewedStripInputKernel>([=]() {
+                            for (uindex_t i = 0; i < n_input_cells; i++) {
+                                uindex_t ic = i / n_input_rows;
+                                uindex_t ir = i % n_input_rows;
+                                if (!ExecutionKernelImpl::is_strip_input(ic, ir)) {
+                                    continue;
+                                }
+                                if (ic < strip_width) {
+                                    strip_in_pipe::write(column_ac[ic][tile_r_offset + ir]);
+                                } else {
+                                    strip_in_pipe::write(row_ac[ic - strip_width][ir]);
+                                }
+                            }
+                        });
+                    });
+                }
+
+                cl::sycl::event computation_event = queue.submit([&](cl::sycl::handler &cgh) {
+                    cgh.single_task(ExecutionKernelImpl(
+                        this->get_trans_func(), i_generation, target_i_generation,
+                        tile_c_offset, tile_r_offset, n_columns, n_rows, grid_width, grid_height,
+                        halo_value));
+                });
+                events.push_back(computation_event);
+
+                cl::sycl::event output_event = queue.submit([&](cl::sycl::handler &cgh) {
+                    auto ac = out_buffer.template get_access<cl::sycl::access::mode::write>(cgh);
+
+                    cgh.single_task<class SkewedOutputKernel>([=]() {
+                        index_t c_offset = index_t(tile_c_offset) - index_t(skew);
+                        index_t r_offset = index_t(tile_r_offset) - index_t(skew);
+                        [[intel::loop_coalesce(2)]] for (uindex_t tile_c = 0; tile_c < n_columns;
+                                                         tile_c++) {
+                            for (uindex_t tile_r = 0; tile_r < n_rows; tile_r++) {
+                                index_t grid_c = c_offset + index_t(tile_c);
+                                index_t grid_r = r_offset + index_t(tile_r);
+                                T value = out_pipe::read();
+                                if (grid_c >= 0 && grid_r >= 0 && grid_c < grid_width &&
+                                    grid_r < grid_height) {
+                                    ac[grid_c][grid_r] = value;
+                                }
+                            }
+                        }
+                    });
+                });
+
+                cl::sycl::event strip_output_event;
+                if constexpr (pipeline_length > 1) {
+                    strip_output_event = queue.submit([&](cl::sycl::handler &cgh) {
+                        auto column_ac =
+                            column_strips[(c + 1) % 2]
+                                .template get_access<cl::sycl::access::mode::write>(cgh);
+                        auto row_ac = row_strips[(r + 1) % 2]
+                                          .template get_access<cl::sycl::access::mode::write>(cgh);
+
+                        cgh.single_task<class SkewedStripOutputKernel>([=]() {
+                            for (uindex_t i = 0; i < n_input_cells; i++) {
+                                uindex_t ic = i / n_input_rows;
+                                uindex_t ir = i % n_input_rows;
+                                if (!ExecutionKernelImpl::is_strip_output(ic, ir)) {
+                                    continue;
+                                }
+                                StripImpl strip = strip_out_pipe::read();
+                                if (ic >= tile_width) {
+                                    column_ac[ic - tile_width][tile_r_offset + ir] = strip;
+                                }
+                                if (ir >= tile_height) {
+                                    row_ac[ic - strip_width][ir - tile_height] = strip;
+                                }
+                            }
+                        });
+                    });
+                }
+
+                if (this->is_runtime_analysis_enabled()) {
+                    RuntimeSample &sample = this->get_runtime_sample();
+                    double n_strip_bytes = pipeline_length > 1
+                                               ? double(n_input_cells - n_columns * n_rows) *
+                                                     sizeof(StripImpl)
+                                               : 0.0;
+                    sample.add_kernel(RuntimeSample::KernelCategory::INPUT, UID(c, r),
+                                      input_event, double(n_input_cells) * sizeof(T));
+                    if constexpr (pipeline_length > 1) {
+                        sample.add_kernel(RuntimeSample::KernelCategory::INPUT, UID(c, r),
+                                          strip_input_event, n_strip_bytes);
+                    }
+                    sample.add_kernel(RuntimeSample::KernelCategory::EXECUTION, UID(c, r),
+                                      computation_event);
+                    sample.add_kernel(RuntimeSample::KernelCategory::OUTPUT, UID(c, r),
+                                      output_event, double(n_columns) * n_rows * sizeof(T));
+                    if constexpr (pipeline_length > 1) {
+                        sample.add_kernel(RuntimeSample::KernelCategory::OUTPUT, UID(c, r),
+                                          strip_output_event, n_strip_bytes);
+                    }
+                }
+            }
+        }
+
+        if (this->is_runtime_analysis_enabled()) {
+            double earliest_start = std::numeric_limits<double>::max();
+            double latest_end = std::numeric_limits<double>::min();
+
+            for (cl::sycl::event event : events) {
+                earliest_start = std::min(earliest_start, RuntimeSample::start_of_event(event));
+                latest_end = std::max(latest_end, RuntimeSample::end_of_event(event));
+            }
+            this->get_runtime_sample().add_pass(
+                latest_end - earliest_start,
+                double(grid_width) * grid_height *
+                    std::min(target_i_generation - i_generation, pipeline_length));
+        }
+
+        return out_buffer;
+    }
+
+    static void copy_buffer(cl::sycl::buffer<T, 2> in_buffer, cl::sycl::buffer<T, 2> out_buffer) {
+        auto in_ac = in_buffer.template get_access<cl::sycl::access::mode::read>();
+        auto out_ac = out_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+        for (uindex_t c = 0; c < in_buffer.get_range()[0]; c++) {
+            for (uindex_t r = 0; r < in_buffer.get_range()[1]; r++) {
+                out_ac[c][r] = in_ac[c][r];
+            }
+        }
+    }
+
+    cl::sycl::buffer<T, 2> grid_buffer;
+};
+} // namespace stencil
@@ -20,6 +20,7 @@
 #pragma once
 #include "GenericID.hpp"
 #include "Index.hpp"
+#include <type_traits>
 
 namespace stencil {
 
@@ -105,6 +106,36 @@ template <typename T, uindex_t radius> class Stencil {
      */
     T &operator[](UID id) { return internal[id.c][id.r]; }
 
+    /**
+     * \brief Access a cell in the stencil with a compile-time offset.
+     *
+     * The origin of the offset is the central cell, like for \ref Stencil.operator[](ID). Offsets
+     * outside of the stencil are rejected at compile time.
+     *
+     * \tparam c The column offset of the cell.
+     * \tparam r The row offset of the cell.
+     */
+    template <index_t c, index_t r> T const &get() const {
+        static_assert(c >= -index_t(radius) && c <= index_t(radius));
+        static_assert(r >= -index_t(radius) && r <= index_t(radius));
+        return internal[c + radius][r + radius];
+    }
+
+    /**
+     * \brief Access a cell in the stencil with a compile-time offset.
+     *
+     * The origin of the offset is the central cell, like for \ref Stencil.operator[](ID). Offsets
+     * outside of the stencil are rejected at compile time.
+     *
+     * \tparam c The column offset of the cell.
+     * \tparam r The row offset of the cell.
+     */
+    template <index_t c, index_t r> T &get() {
+        static_assert(c >= -index_t(radius) && c <= index_t(radius));
+        static_assert(r >= -index_t(radius) && r <= index_t(radius));
+        return internal[c + radius][r + radius];
+    }
+
     /**
      * \brief The position of the central cell in the global grid.
      */
@@ -133,7 +164,9 @@ template <typename T, uindex_t radius> class Stencil {
      * }
      * ```
      * `foo` will only be synthesized for even pipeline stages, and `bar` will only be synthesized
-     * for odd pipeline stages.
+     * for odd pipeline stages. \ref TransFuncSequence implements this pattern for any number of
+     * transition functions. Transition functions that rely on it should declare a \ref
+     * stage_period, so that the executors apply the data paths in order.
      */
     const uindex_t stage;
 
@@ -146,4 +179,92 @@ template <typename T, uindex_t radius> class Stencil {
     T internal[diameter][diameter];
 };
 
+/**
+ * \brief Check whether a transition function declares the stencil cells it reads.
+ *
+ * This is the case if the transition function type has a static member function `accesses`, as
+ * described in \ref StencilAccessSet.
+ */
+template <typename TransFunc, typename = void> struct has_access_set : std::false_type {};
+
+template <typename TransFunc>
+struct has_access_set<TransFunc,
+                      std::void_t<decltype(TransFunc::accesses(index_t(0), index_t(0)))>>
+    : std::true_type {};
+
+/**
+ * \brief The set of stencil cells that is read by a transition function.
+ *
+ * By default, a transition function may read every cell of the stencil. A transition function can
+ * declare a smaller access set with a static member function:
+ * ```
+ * static constexpr bool accesses(index_t c, index_t r);
+ * ```
+ * It returns true if the transition function may read the cell at the offset `(c, r)` from the
+ * central cell. The execution kernels neither fill nor shift stencil buffer cells that are never
+ * read, which removes the registers, copies and halo substitutions of these cells. Reading a cell
+ * outside of the declared set returns an unspecified value.
+ *
+ * The central cell is always stored, since the kernels need it to pass cells through stages that
+ * do not compute a new generation.
+ *
+ * All methods take unsigned indices with the north-western corner of the stencil as origin.
+ *
+ * \tparam TransFunc The type of the transition function.
+ * \tparam radius The radius of the stencil.
+ */
+template <typename TransFunc, uindex_t radius, bool declared = has_access_set<TransFunc>::value>
+struct StencilAccessSet {
+    /**
+     * \brief Check whether the transition function may read the cell.
+     */
+    static constexpr bool is_read(uindex_t c, uindex_t r) { return true; }
+
+    /**
+     * \brief Check whether the cell has to be stored in the stencil buffer.
+     *
+     * This is the case if the cell itself or any cell north of it in the same column is read by the
+     * transition function or is the central cell, since the cells move north in the buffer.
+     */
+    static constexpr bool is_stored(uindex_t c, uindex_t r) { return true; }
+};
+
+template <typename TransFunc, uindex_t radius> struct StencilAccessSet<TransFunc, radius, true> {
+    static constexpr bool is_read(uindex_t c, uindex_t r) {
+        return TransFunc::accesses(index_t(c) - index_t(radius), index_t(r) - index_t(radius));
+    }
+
+    static constexpr bool is_stored(uindex_t c, uindex_t r) {
+        for (uindex_t north_r = 0; north_r <= r; north_r++) {
+            if (is_read(c, north_r) || (c == radius && north_r == radius)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * \brief The number of pipeline stages after which the data paths of a transition function repeat.
+ *
+ * A transition function that selects its data path with \ref Stencil.stage declares the period
+ * with a static member:
+ * ```
+ * static constexpr uindex_t stage_period;
+ * ```
+ * Stage `s` then computes the data path `s % stage_period`, which only yields the intended order if
+ * every pass starts with a generation index that is a multiple of the period. Therefore, the
+ * execution kernels require the pipeline length to be a multiple of the period, and the executors
+ * reject passes that do not start at a multiple of it. Transition functions without a declared
+ * period have a period of 1.
+ *
+ * \tparam TransFunc The type of the transition function.
+ */
+template <typename TransFunc, typename = void>
+struct stage_period : std::integral_constant<uindex_t, 1> {};
+
+template <typename TransFunc>
+struct stage_period<TransFunc, std::void_t<decltype(TransFunc::stage_period)>>
+    : std::integral_constant<uindex_t, TransFunc::stage_period> {};
+
 } // namespace stencil
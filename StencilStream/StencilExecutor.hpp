@@ -18,9 +18,17 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #pragma once
+#include "PerformanceModel.hpp"
+#include "Reduction.hpp"
 #include "SingleQueueExecutor.hpp"
+#include "TileOrder.hpp"
 #include "tiling/ExecutionKernel.hpp"
 #include "tiling/Grid.hpp"
+#include "tiling/GridFile.hpp"
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <typeinfo>
 
 namespace stencil {
 /**
@@ -43,9 +51,13 @@ namespace stencil {
  * \tparam tile_height The number of rows in a tile and maximum number of rows in a grid. Defaults
  * to 1024.
  * \tparam burst_size The number of bytes to load/store in one burst. Defaults to 1024.
+ * \tparam Grid The template of the grid that stores the tiles. Defaults to \ref tiling::Grid, which
+ * stores the tiles in device memory. \ref tiling::OutOfCoreGrid may be used for grids that don't
+ * fit into device memory.
  */
 template <typename T, uindex_t stencil_radius, typename TransFunc, uindex_t pipeline_length = 1,
-          uindex_t tile_width = 1024, uindex_t tile_height = 1024, uindex_t burst_size = 1024>
+          uindex_t tile_width = 1024, uindex_t tile_height = 1024, uindex_t burst_size = 1024,
+          template <typename, uindex_t, uindex_t, uindex_t, uindex_t> typename Grid = tiling::Grid>
 class StencilExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc> {
   public:
     /**
@@ -64,6 +76,22 @@ class StencilExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc>
      */
     using Parent = SingleQueueExecutor<T, stencil_radius, TransFunc>;
 
+    /**
+     * \brief The type of the internal grid.
+     */
+    using GridImpl = Grid<T, tile_width, tile_height, halo_radius, burst_length>;
+
+    /**
+     * \brief The type of the checkpoint files.
+     */
+    using CheckpointFile = tiling::GridFile<T, tile_width, tile_height, halo_radius, burst_length>;
+
+    /**
+     * \brief The analytical performance model of this executor's configuration.
+     */
+    using PerformanceModel =
+        TilingPerformanceModel<T, stencil_radius, pipeline_length, tile_width, tile_height>;
+
     /**
      * \brief Create a new stencil executor.
      *
@@ -72,73 +100,562 @@ class StencilExecutor : public SingleQueueExecutor<T, stencil_radius, TransFunc>
      */
     StencilExecutor(T halo_value, TransFunc trans_func)
         : Parent(halo_value, trans_func),
-          input_grid(cl::sycl::buffer<T, 2>(cl::sycl::range<2>(0, 0))) {}
+          input_grid(cl::sycl::buffer<T, 2>(cl::sycl::range<2>(0, 0))), activity_tracking(false),
+          changed_tiles(std::nullopt), domain_tiles(std::nullopt), domain_mask_range(0, 0),
+          last_pass_length(0), n_skipped_tiles(0), tile_order(TileOrder::COLUMN_MAJOR) {}
 
     void set_input(cl::sycl::buffer<T, 2> input_buffer) override {
         this->input_grid = GridImpl(input_buffer);
+        this->changed_tiles = std::nullopt;
     }
 
     void copy_output(cl::sycl::buffer<T, 2> output_buffer) override {
         input_grid.copy_to(output_buffer);
     }
 
+    /**
+     * \brief Copy a strided region of the grid to a buffer.
+     *
+     * The cell `(c, r)` of the output buffer is set to the grid cell `(region_offset.c + c *
+     * stride.c, region_offset.r + r * stride.r)`, which means that the output buffer must have the
+     * range `ceil(region_range / stride)`. Only the tile parts that intersect
+     * the region are accessed and the cells are picked on the device, so that only the requested
+     * cells are transferred.
+     *
+     * \param output_buffer The target buffer.
+     * \param region_offset The index of the north-western corner of the region.
+     * \param region_range The number of columns and rows of the region.
+     * \param stride The distance between two copied cells in every direction.
+     * \throws std::invalid_argument The stride is zero in any direction.
+     * \throws std::out_of_range The region exceeds the grid.
+     * \throws std::range_error The output buffer does not have the required range.
+     */
+    void copy_output(cl::sycl::buffer<T, 2> output_buffer, UID region_offset, UID region_range,
+                     UID stride = UID(1, 1)) {
+        if (stride.c == 0 || stride.r == 0) {
+            throw std::invalid_argument("The stride must not be zero");
+        }
+        if (region_offset.c + region_range.c > get_grid_range().c ||
+            region_offset.r + region_range.r > get_grid_range().r) {
+            throw std::out_of_range("The requested region exceeds the grid");
+        }
+        cl::sycl::range<2> output_range((region_range.c + stride.c - 1) / stride.c,
+                                        (region_range.r + stride.r - 1) / stride.r);
+        if (output_buffer.get_range() != output_range) {
+            throw std::range_error("The output buffer does not have the range of the region");
+        }
+
+        input_grid.copy_to(this->get_queue(), output_buffer, region_offset, stride);
+    }
+
+    /**
+     * \brief Set the internal grid directly.
+     *
+     * Unlike \ref StencilExecutor.set_input, the cells are neither copied nor repartitioned. This
+     * can be used to supply a grid that has been configured or filled by other means. It does not
+     * reset the generation index.
+     *
+     * \param grid The new grid.
+     */
+    void set_grid(GridImpl grid) {
+        this->input_grid = grid;
+        this->changed_tiles = std::nullopt;
+    }
+
+    /**
+     * \brief Get the internal grid.
+     *
+     * The returned grid shares its tiles with the executor, but the executor never alters the tiles
+     * of a grid after its creation: \ref StencilExecutor.run stores every new generation in new
+     * tiles.
+     */
+    GridImpl get_grid() const { return input_grid; }
+
     UID get_grid_range() const override { return input_grid.get_grid_range(); }
 
+    /**
+     * \brief Write the grid and the generation index to a checkpoint file.
+     *
+     * A checkpoint is a \ref tiling::GridFile, which stores the tiles in their native layout, with
+     * the generation index and the \ref StencilExecutor.get_config_hash in its header. The halo
+     * value and the transition function instance are not stored and have to be restored by the
+     * application.
+     *
+     * \param path The path of the checkpoint file.
+     * \throws std::runtime_error Thrown if the file could not be written.
+     */
+    void save_checkpoint(std::string const &path) {
+        CheckpointFile::write(path, input_grid, this->get_i_generation(), get_config_hash());
+    }
+
+    /**
+     * \brief Write the grid and the generation index to a checkpoint file in a separate thread.
+     *
+     * This works like \ref StencilExecutor.save_checkpoint, but the file is written by another
+     * thread while the executor may continue to compute the next generations. Since the executor
+     * never alters the tiles of a grid after its creation, the checkpoint always contains the
+     * state at the time of the call.
+     *
+     * \param path The path of the checkpoint file.
+     * \return A future that becomes ready once the file is written. It rethrows the exceptions of
+     * \ref StencilExecutor.save_checkpoint.
+     */
+    std::future<void> save_checkpoint_async(std::string const &path) {
+        return std::async(std::launch::async,
+                          [path, grid = input_grid, i_generation = this->get_i_generation()]() {
+                              GridImpl checkpoint_grid = grid;
+                              CheckpointFile::write(path, checkpoint_grid, i_generation,
+                                                    get_config_hash());
+                          });
+    }
+
+    /**
+     * \brief Restore the grid and the generation index from a checkpoint file.
+     *
+     * The tiles are loaded in their native layout, so the grid is not repartitioned. If the
+     * internal grid is an \ref tiling::OutOfCoreGrid, the file is mapped into memory instead of
+     * being read.
+     *
+     * \param path The path of the checkpoint file.
+     * \throws std::runtime_error Thrown if the file could not be read or has been written by an
+     * executor with a different configuration.
+     */
+    void load_checkpoint(std::string const &path) {
+        typename CheckpointFile::Header header = CheckpointFile::read_header(path);
+        if (header.config_hash != get_config_hash()) {
+            throw std::runtime_error("The checkpoint " + path +
+                                     " has been written by an executor with a different "
+                                     "configuration");
+        }
+
+        if constexpr (std::is_same<GridImpl, typename CheckpointFile::OutOfCoreGridImpl>::value) {
+            input_grid = CheckpointFile::map_grid(path);
+        } else {
+            input_grid = CheckpointFile::read_grid(path);
+        }
+        this->set_i_generation(header.i_generation);
+        changed_tiles = std::nullopt;
+    }
+
+    /**
+     * \brief Get the hash of the executor configuration that is stored in checkpoints.
+     *
+     * It covers the cell and transition function types as well as all template parameters that
+     * influence the computation or the tile layout. It is computed with the FNV-1a hash function
+     * and therefore stable across runs of the same program.
+     */
+    static uint64_t get_config_hash() {
+        std::string config = std::string(typeid(T).name()) + ";" + typeid(TransFunc).name() +
+                             ";" + std::to_string(stencil_radius) + ";" +
+                             std::to_string(pipeline_length) + ";" + std::to_string(tile_width) +
+                             ";" + std::to_string(tile_height) + ";" +
+                             std::to_string(burst_length);
+
+        uint64_t hash = 0xcbf29ce484222325;
+        for (char c : config) {
+            hash ^= uint8_t(c);
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
     void run(uindex_t n_generations) override {
+        uindex_t target_i_generation = this->get_i_generation() + n_generations;
+
+        while (this->get_i_generation() < target_i_generation) {
+            input_grid = run_pass(input_grid, this->get_trans_func(), this->get_i_generation(),
+                                  target_i_generation, activity_tracking);
+
+            this->inc_i_generation(
+                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+        }
+    }
+
+    /**
+     * \brief Compute generations until a reduction of the last pass satisfies a predicate.
+     *
+     * The reduction is computed by the execution kernels themselves: The last computing stage of
+     * every tile maps every cell of the tile with its value in the second-to-last and in the last
+     * generation of the pass and combines the results. Every tile writes its partial value to a
+     * small buffer, and only these partial values are transferred back to the host and combined.
+     * Therefore, no additional kernels or memory accesses are needed, and the reduced value
+     * always describes the difference between the last two generations. The computation stops as
+     * soon as `predicate` returns true for the reduced value, or after `max_generations`
+     * generations. Since this is checked after every pass, the number of computed generations is a
+     * multiple of `pipeline_length` unless `max_generations` is reached.
+     *
+     * Tiles that have been skipped by the activity tracking or the domain mask contribute the
+     * identity of the reduction. Since the execution kernel with a reduction is a different kernel
+     * than the one of \ref run, using both methods requires both kernels on the device.
+     *
+     * \tparam Reduction The type of the reduction, see \ref MaxAbsDifference for the
+     * requirements.
+     * \tparam Predicate The type of the predicate, invocable with a `Reduction::Value`.
+     * \param reduction The reduction instance.
+     * \param predicate The predicate that decides whether the computation is finished.
+     * \param max_generations The maximal number of generations to compute.
+     * \return The reduced value of the last pass, or `reduction.identity()` if no pass has been
+     * computed.
+     */
+    template <typename Reduction, typename Predicate>
+    typename Reduction::Value run_until(Reduction reduction, Predicate predicate,
+                                        uindex_t max_generations) {
+        using Value = typename Reduction::Value;
+        uindex_t target_i_generation = this->get_i_generation() + max_generations;
+        Value value = reduction.identity();
+
+        while (this->get_i_generation() < target_i_generation) {
+            UID tile_range = input_grid.get_tile_range();
+            uindex_t n_tiles = tile_range.c * tile_range.r;
+            cl::sycl::range<1> partials_range(n_tiles);
+            cl::sycl::buffer<Value, 1> partials(partials_range);
+            {
+                auto partials_ac =
+                    partials.template get_access<cl::sycl::access::mode::discard_write>();
+                for (uindex_t i = 0; i < n_tiles; i++) {
+                    partials_ac[i] = reduction.identity();
+                }
+            }
+
+            input_grid = run_pass(input_grid, this->get_trans_func(), this->get_i_generation(),
+                                  target_i_generation, activity_tracking, reduction, partials);
+            this->inc_i_generation(
+                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+
+            auto partials_ac = partials.template get_access<cl::sycl::access::mode::read>();
+            value = reduction.identity();
+            for (uindex_t i = 0; i < n_tiles; i++) {
+                value = reduction.combine(value, partials_ac[i]);
+            }
+            if (predicate(value)) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    /**
+     * \brief Compute the next generations of the grid with multiple transition function instances.
+     *
+     * Every instance in `trans_funcs` is a member of the ensemble and the next `n_generations`
+     * generations of the grid are computed for every member, starting from the current state of
+     * the grid. All members share the tiled input grid, so it is neither copied nor repartitioned.
+     * The passes of all members are submitted alternately without waiting for the host in
+     * between, which keeps the device busy.
+     *
+     * The grid, the generation index and the transition function instance of the executor are not
+     * altered. If the runtime analysis is enabled, the kernels and passes of all members are
+     * recorded in the executor's runtime sample, just like the passes of \ref run.
+     *
+     * \param trans_funcs The transition function instances of the ensemble members.
+     * \param n_generations The number of generations to calculate.
+     * \return The resulting grids of the members, in the same order as `trans_funcs`.
+     */
+    std::vector<cl::sycl::buffer<T, 2>> run_ensemble(std::vector<TransFunc> const &trans_funcs,
+                                                     uindex_t n_generations) {
+        std::vector<GridImpl> member_grids(trans_funcs.size(), input_grid);
+
+        uindex_t i_generation = this->get_i_generation();
+        uindex_t target_i_generation = i_generation + n_generations;
+
+        while (i_generation < target_i_generation) {
+            for (uindex_t i_member = 0; i_member < trans_funcs.size(); i_member++) {
+                member_grids[i_member] = run_pass(member_grids[i_member], trans_funcs[i_member],
+                                                  i_generation, target_i_generation, false);
+            }
+            i_generation += std::min(target_i_generation - i_generation, pipeline_length);
+        }
+
+        std::vector<cl::sycl::buffer<T, 2>> output_buffers;
+        output_buffers.reserve(trans_funcs.size());
+        for (GridImpl &member_grid : member_grids) {
+            UID grid_range = member_grid.get_grid_range();
+            cl::sycl::buffer<T, 2> output_buffer(cl::sycl::range<2>(grid_range.c, grid_range.r));
+            member_grid.copy_to(output_buffer);
+            output_buffers.push_back(output_buffer);
+        }
+        return output_buffers;
+    }
+
+    /**
+     * \brief Enable or disable the activity tracking.
+     *
+     * If enabled, \ref StencilExecutor.run records which tiles have been changed by a pass. In the
+     * next pass, a tile is skipped if neither the tile nor any of its neighbors have been changed,
+     * and the tile of the previous pass is used instead. This can save a lot of computations for
+     * sparse workloads where most tiles are resting, but it requires a synchronization with the
+     * host after every pass and a comparison of every computed tile with its input.
+     *
+     * Skipping is only correct if the transition function computes the same new cell value for
+     * the same neighborhood, regardless of the generation index or other state. This is why it is
+     * disabled by default. Tiles are only skipped if the previous pass has computed the same
+     * number of generations. Cells are compared bitwise.
+     *
+     * \param enable Whether the activity tracking should be enabled.
+     */
+    void set_activity_tracking(bool enable) {
+        activity_tracking = enable;
+        changed_tiles = std::nullopt;
+    }
+
+    /**
+     * \brief Check whether the activity tracking is enabled.
+     */
+    bool is_activity_tracking_enabled() const { return activity_tracking; }
+
+    /**
+     * \brief Get the number of tile computations that have been skipped by the activity tracking.
+     */
+    uindex_t get_n_skipped_tiles() const { return n_skipped_tiles; }
+
+    /**
+     * \brief Set the order in which the tiles of a pass are processed.
+     *
+     * The order does not change the results, but it changes which parts of the global memory are
+     * accessed by consecutive tiles. The best order depends on the grid range and the memory
+     * system, so it should be chosen with measurements, for example with the benchmark in
+     * `tests/src/bench`. Defaults to \ref TileOrder::COLUMN_MAJOR.
+     *
+     * \param order The new tile order.
+     */
+    void set_tile_order(TileOrder order) { tile_order = order; }
+
+    /**
+     * \brief Get the order in which the tiles of a pass are processed.
+     */
+    TileOrder get_tile_order() const { return tile_order; }
+
+    /**
+     * \brief Set a static mask of the computational domain.
+     *
+     * A cell is inside the domain if its value in the mask is true. Tiles that contain no cell
+     * inside the domain are never computed. Instead, the cells of these tiles keep their values,
+     * and neighboring tiles read them as constant halo. Tiles with at least one cell inside the
+     * domain are computed completely, so the transition function still has to handle cells
+     * outside the domain.
+     *
+     * The mask has to have the same range as the grid when \ref StencilExecutor.run or \ref
+     * StencilExecutor.run_ensemble is called.
+     *
+     * \param domain_mask The mask of the computational domain.
+     */
+    void set_domain_mask(cl::sycl::buffer<bool, 2> domain_mask) {
+        domain_mask_range = UID(domain_mask.get_range()[0], domain_mask.get_range()[1]);
+        UID tile_range((domain_mask_range.c + tile_width - 1) / tile_width,
+                       (domain_mask_range.r + tile_height - 1) / tile_height);
+
+        domain_tiles = std::vector<bool>(tile_range.c * tile_range.r, false);
+        auto mask_ac = domain_mask.template get_access<cl::sycl::access::mode::read>();
+        for (uindex_t c = 0; c < domain_mask_range.c; c++) {
+            for (uindex_t r = 0; r < domain_mask_range.r; r++) {
+                if (mask_ac[c][r]) {
+                    (*domain_tiles)[(c / tile_width) * tile_range.r + r / tile_height] = true;
+                }
+            }
+        }
+    }
+
+    /**
+     * \brief Remove the domain mask, so that all tiles are computed again.
+     */
+    void clear_domain_mask() { domain_tiles = std::nullopt; }
+
+    /**
+     * \brief Check whether a tile contains any cell of the computational domain.
+     *
+     * This is always true if no domain mask is set.
+     *
+     * \param tile_id The id of the tile.
+     */
+    bool is_tile_in_domain(UID tile_id) const {
+        if (!domain_tiles.has_value()) {
+            return true;
+        }
+        uindex_t n_tile_rows = (domain_mask_range.r + tile_height - 1) / tile_height;
+        return (*domain_tiles)[tile_id.c * n_tile_rows + tile_id.r];
+    }
+
+  private:
+    /**
+     * \brief Submit all kernels of one pass over the grid.
+     *
+     * \param pass_input_grid The grid to read the cells from.
+     * \param trans_func The transition function instance to use.
+     * \param i_generation The generation index of the input grid.
+     * \param target_i_generation The generation index to compute. At most `pipeline_length`
+     * generations are computed.
+     * \param track_activity Whether tiles should be skipped and compared as described in \ref
+     * StencilExecutor.set_activity_tracking. Must only be true for passes over the internal grid.
+     * \param reduction The reduction that the execution kernels compute, see \ref run_until.
+     * \param partials The buffer for the reduced values of the tiles, with one entry per tile in
+     * column-major order. The entries of skipped tiles are not written. Only used if a reduction
+     * other than \ref NoReduction is given.
+     * \return The output grid of the pass.
+     */
+    template <typename Reduction = NoReduction>
+    GridImpl run_pass(
+        GridImpl &pass_input_grid, TransFunc trans_func, uindex_t i_generation,
+        uindex_t target_i_generation, bool track_activity, Reduction reduction = Reduction(),
+        std::optional<cl::sycl::buffer<typename Reduction::Value, 1>> partials = std::nullopt) {
         using in_pipe = cl::sycl::pipe<class tiling_in_pipe, T>;
         using out_pipe = cl::sycl::pipe<class tiling_out_pipe, T>;
         using ExecutionKernelImpl =
             tiling::ExecutionKernel<TransFunc, T, stencil_radius, pipeline_length, tile_width,
                                     tile_height, in_pipe, out_pipe>;
 
+        this->check_pass_start(i_generation);
         cl::sycl::queue &queue = this->get_queue();
 
-        uindex_t target_i_generation = this->get_i_generation() + n_generations;
-        uindex_t grid_width = input_grid.get_grid_range().c;
-        uindex_t grid_height = input_grid.get_grid_range().r;
+        uindex_t grid_width = pass_input_grid.get_grid_range().c;
+        uindex_t grid_height = pass_input_grid.get_grid_range().r;
 
-        while (this->get_i_generation() < target_i_generation) {
-            GridImpl output_grid = input_grid.make_output_grid();
+        if (domain_tiles.has_value() && (grid_width != domain_mask_range.c ||
+                                         grid_height != domain_mask_range.r)) {
+            throw std::range_error("The domain mask does not have the same range as the grid");
+        }
+
+        GridImpl output_grid = pass_input_grid.make_output_grid();
+        UID tile_range = pass_input_grid.get_tile_range();
+        uindex_t pass_length = std::min(target_i_generation - i_generation, pipeline_length);
+        bool skip_resting_tiles =
+            track_activity && changed_tiles.has_value() && pass_length == last_pass_length;
 
-            std::vector<cl::sycl::event> events;
-            events.reserve(input_grid.get_tile_range().c * input_grid.get_tile_range().r);
+        std::vector<cl::sycl::event> events;
+        events.reserve(tile_range.c * tile_range.r);
+        std::vector<UID> computed_tiles;
 
-            for (uindex_t c = 0; c < input_grid.get_tile_range().c; c++) {
-                for (uindex_t r = 0; r < input_grid.get_tile_range().r; r++) {
-                    input_grid.template submit_tile_input<in_pipe>(queue, UID(c, r));
+        for (UID tile_id : get_tile_schedule(tile_order, tile_range)) {
+            if (!is_tile_in_domain(tile_id)) {
+                output_grid.take_tile(pass_input_grid, tile_id);
+                continue;
+            }
+            if (skip_resting_tiles && !is_neighborhood_changed(tile_id, tile_range)) {
+                output_grid.take_tile(pass_input_grid, tile_id);
+                n_skipped_tiles++;
+                continue;
+            }
+            computed_tiles.push_back(tile_id);
 
-                    cl::sycl::event computation_event = queue.submit([&](cl::sycl::handler &cgh) {
-                        cgh.single_task(ExecutionKernelImpl(
-                            this->get_trans_func(), this->get_i_generation(), target_i_generation,
-                            c * tile_width, r * tile_height, grid_width, grid_height,
-                            this->get_halo_value()));
-                    });
-                    events.push_back(computation_event);
+            std::vector<cl::sycl::event> input_events =
+                pass_input_grid.template submit_tile_input<in_pipe>(queue, tile_id);
 
-                    output_grid.template submit_tile_output<out_pipe>(queue, UID(c, r));
+            cl::sycl::event computation_event = queue.submit([&](cl::sycl::handler &cgh) {
+                ExecutionKernelImpl kernel(trans_func, i_generation, target_i_generation,
+                                           tile_id.c * tile_width, tile_id.r * tile_height,
+                                           grid_width, grid_height, this->get_halo_value());
+                if constexpr (std::is_same_v<Reduction, NoReduction>) {
+                    cgh.single_task(kernel);
+                } else {
+                    auto partials_ac =
+                        partials->template get_access<cl::sycl::access::mode::write>(cgh);
+                    uindex_t i_tile = tile_id.c * tile_range.r + tile_id.r;
+                    cgh.single_task<class TilingReductionKernel>(
+                        [=]() { partials_ac[i_tile] = kernel(reduction); });
                 }
-            }
+            });
+            events.push_back(computation_event);
 
-            input_grid = output_grid;
+            std::vector<cl::sycl::event> output_events =
+                output_grid.template submit_tile_output<out_pipe>(queue, tile_id);
 
             if (this->is_runtime_analysis_enabled()) {
-                double earliest_start = std::numeric_limits<double>::max();
-                double latest_end = std::numeric_limits<double>::min();
+                record_tile_kernels(tile_id, input_events, computation_event, output_events);
+            }
+        }
 
-                for (cl::sycl::event event : events) {
-                    earliest_start = std::min(earliest_start, RuntimeSample::start_of_event(event));
-                    latest_end = std::max(latest_end, RuntimeSample::end_of_event(event));
+        if (track_activity) {
+            uindex_t n_tiles = tile_range.c * tile_range.r;
+            cl::sycl::range<1> flags_range(n_tiles);
+            cl::sycl::buffer<bool, 1> changed_flags(flags_range);
+            {
+                auto flags_ac =
+                    changed_flags.template get_access<cl::sycl::access::mode::discard_write>();
+                for (uindex_t i = 0; i < n_tiles; i++) {
+                    flags_ac[i] = false;
                 }
-                this->get_runtime_sample().add_pass(latest_end - earliest_start);
+            }
+            for (UID tile_id : computed_tiles) {
+                output_grid.submit_tile_comparison(queue, pass_input_grid, tile_id, changed_flags);
             }
 
-            this->inc_i_generation(
-                std::min(target_i_generation - this->get_i_generation(), pipeline_length));
+            auto flags_ac = changed_flags.template get_access<cl::sycl::access::mode::read>();
+            changed_tiles = std::vector<bool>(n_tiles);
+            for (uindex_t i = 0; i < n_tiles; i++) {
+                (*changed_tiles)[i] = flags_ac[i];
+            }
+            last_pass_length = pass_length;
+        }
+
+        if (this->is_runtime_analysis_enabled()) {
+            double earliest_start = std::numeric_limits<double>::max();
+            double latest_end = std::numeric_limits<double>::min();
+
+            for (cl::sycl::event event : events) {
+                earliest_start = std::min(earliest_start, RuntimeSample::start_of_event(event));
+                latest_end = std::max(latest_end, RuntimeSample::end_of_event(event));
+            }
+            // All tiles may have been skipped by the activity tracking.
+            this->get_runtime_sample().add_pass(events.empty() ? 0.0 : latest_end - earliest_start,
+                                                double(grid_width) * grid_height * pass_length);
         }
+
+        return output_grid;
+    }
+
+    /**
+     * \brief Add the kernels submitted for a tile to the runtime sample.
+     *
+     * The number of transferred bytes is derived from the columns that are read and written by the
+     * IO kernels, see \ref tiling::Grid.submit_tile_input and \ref tiling::Grid.submit_tile_output.
+     * The execution kernel does not access global memory.
+     */
+    void record_tile_kernels(UID tile_id, std::vector<cl::sycl::event> const &input_events,
+                             cl::sycl::event computation_event,
+                             std::vector<cl::sycl::event> const &output_events) {
+        constexpr uindex_t core_width = tile_width - 2 * halo_radius;
+        constexpr uindex_t input_column_widths[] = {halo_radius, halo_radius, core_width,
+                                                    halo_radius, halo_radius};
+        constexpr uindex_t output_column_widths[] = {halo_radius, core_width, halo_radius};
+        RuntimeSample &sample = this->get_runtime_sample();
+
+        for (uindex_t i = 0; i < input_events.size(); i++) {
+            double n_bytes =
+                double(input_column_widths[i]) * (tile_height + 2 * halo_radius) * sizeof(T);
+            sample.add_kernel(RuntimeSample::KernelCategory::INPUT, tile_id, input_events[i],
+                              n_bytes);
+        }
+        sample.add_kernel(RuntimeSample::KernelCategory::EXECUTION, tile_id, computation_event);
+        for (uindex_t i = 0; i < output_events.size(); i++) {
+            double n_bytes = double(output_column_widths[i]) * tile_height * sizeof(T);
+            sample.add_kernel(RuntimeSample::KernelCategory::OUTPUT, tile_id, output_events[i],
+                              n_bytes);
+        }
+    }
+
+    /**
+     * \brief Check whether a tile or any of its neighbors has been changed by the last pass.
+     */
+    bool is_neighborhood_changed(UID tile_id, UID tile_range) const {
+        for (index_t delta_c = -1; delta_c <= 1; delta_c++) {
+            for (index_t delta_r = -1; delta_r <= 1; delta_r++) {
+                index_t c = index_t(tile_id.c) + delta_c;
+                index_t r = index_t(tile_id.r) + delta_r;
+                if (c >= 0 && r >= 0 && c < index_t(tile_range.c) && r < index_t(tile_range.r) &&
+                    (*changed_tiles)[c * tile_range.r + r]) {
+                    return true;
+                }
+            }
+        }
+        return false;
     }
 
-  private:
-    using GridImpl = tiling::Grid<T, tile_width, tile_height, halo_radius, burst_length>;
     GridImpl input_grid;
+    bool activity_tracking;
+    std::optional<std::vector<bool>> changed_tiles;
+    std::optional<std::vector<bool>> domain_tiles;
+    UID domain_mask_range;
+    uindex_t last_pass_length;
+    uindex_t n_skipped_tiles;
+    TileOrder tile_order;
 };
 } // namespace stencil
\ No newline at end of file
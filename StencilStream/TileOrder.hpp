@@ -0,0 +1,120 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "GenericID.hpp"
+#include "Index.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace stencil {
+/**
+ * \brief The order in which a tiling executor processes the tiles of a pass.
+ *
+ * The input of a tile overlaps with its eight neighbors, and the tiles are stored in separate
+ * buffers. The order therefore determines how close the global memory accesses of consecutive
+ * tiles are and how much of the halo of a tile has just been read for the previous tile.
+ */
+enum class TileOrder {
+    /**
+     * \brief Process the tiles column by column, from north to south in every column. This is the
+     * default order and the \ref indexingorder of the cells.
+     */
+    COLUMN_MAJOR,
+
+    /**
+     * \brief Process the tiles row by row, from west to east in every row.
+     */
+    ROW_MAJOR,
+
+    /**
+     * \brief Process the tiles along the Z-order (Morton) curve, which visits 2x2 blocks of tiles,
+     * 2x2 blocks of these blocks and so on. Consecutive tiles stay close to each other in both
+     * directions.
+     */
+    Z_ORDER,
+
+    /**
+     * \brief Process the tiles column by column, but alternate between north to south and south to
+     * north. Consecutive tiles are always neighbors.
+     */
+    SNAKE,
+};
+
+/**
+ * \brief Get the tiles of a tile range in the given order.
+ *
+ * \param order The order of the tiles.
+ * \param tile_range The number of tile columns and rows.
+ * \return The ids of all tiles in the range, each exactly once.
+ */
+inline std::vector<UID> get_tile_schedule(TileOrder order, UID tile_range) {
+    std::vector<UID> schedule;
+    schedule.reserve(tile_range.c * tile_range.r);
+
+    switch (order) {
+    case TileOrder::ROW_MAJOR:
+        for (uindex_t r = 0; r < tile_range.r; r++) {
+            for (uindex_t c = 0; c < tile_range.c; c++) {
+                schedule.push_back(UID(c, r));
+            }
+        }
+        break;
+    case TileOrder::SNAKE:
+        for (uindex_t c = 0; c < tile_range.c; c++) {
+            for (uindex_t i = 0; i < tile_range.r; i++) {
+                schedule.push_back(UID(c, c % 2 == 0 ? i : tile_range.r - i - 1));
+            }
+        }
+        break;
+    case TileOrder::Z_ORDER: {
+        for (uindex_t c = 0; c < tile_range.c; c++) {
+            for (uindex_t r = 0; r < tile_range.r; r++) {
+                schedule.push_back(UID(c, r));
+            }
+        }
+        // Interleave the bits of the column and row index, with the column bits being the more
+        // significant ones, and sort the tiles by the resulting key.
+        auto get_morton_key = [](UID tile_id) {
+            uint64_t key = 0;
+            for (uindex_t bit = 0; bit < 32; bit++) {
+                key |= uint64_t((tile_id.r >> bit) & 0b1) << (2 * bit);
+                key |= uint64_t((tile_id.c >> bit) & 0b1) << (2 * bit + 1);
+            }
+            return key;
+        };
+        std::sort(schedule.begin(), schedule.end(), [&](UID a, UID b) {
+            return get_morton_key(a) < get_morton_key(b);
+        });
+        break;
+    }
+    case TileOrder::COLUMN_MAJOR:
+    default:
+        for (uindex_t c = 0; c < tile_range.c; c++) {
+            for (uindex_t r = 0; r < tile_range.r; r++) {
+                schedule.push_back(UID(c, r));
+            }
+        }
+        break;
+    }
+
+    return schedule;
+}
+} // namespace stencil
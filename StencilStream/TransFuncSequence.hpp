@@ -0,0 +1,220 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Index.hpp"
+#include "Stencil.hpp"
+#include "UniformTable.hpp"
+#include <tuple>
+
+namespace stencil {
+/**
+ * \brief A transition function that applies a sequence of transition functions cyclically over the
+ * pipeline stages.
+ *
+ * Stage `i` of the pipeline applies the function `i % sizeof...(TransFuncs)` of the sequence. Since
+ * the stage index is hard coded in the final design (see \ref Stencil.stage), every stage is
+ * synthesized from exactly one function of the sequence. This replaces manual branches on the
+ * stage index, like the alternating E- and H-field updates of an FDTD simulation:
+ * ```
+ * using TransFunc = TransFuncSequence<EUpdate, HUpdate>;
+ * StencilExecutor<Cell, 1, TransFunc, 16> executor(halo, TransFunc(EUpdate(), HUpdate()));
+ * ```
+ *
+ * The sequence length is the \ref stage_period of the sequence. Since every pass starts with stage
+ * 0, the pipeline length of the executor has to be a multiple of it, which is checked at compile
+ * time, and the generation index has to be a multiple of it whenever a pass starts. The executors
+ * throw an exception otherwise, so the number of generations of a run should be a multiple of the
+ * sequence length too.
+ *
+ * All functions have to accept a `Stencil<T, stencil_radius> const &` and return the new cell
+ * value of type `T`. Functions that declare uniforms (see \ref UniformTable) are called with their
+ * uniform as well.
+ *
+ * \tparam TransFuncs The types of the transition functions, in the order of their application.
+ */
+template <typename... TransFuncs> class TransFuncSequence {
+  public:
+    /**
+     * \brief The number of transition functions in the sequence.
+     */
+    static constexpr uindex_t n_functions = sizeof...(TransFuncs);
+
+    /**
+     * \brief The number of pipeline stages after which the functions repeat, see \ref
+     * stage_period.
+     */
+    static constexpr uindex_t stage_period = n_functions;
+
+    static_assert(n_functions >= 1);
+
+  private:
+    template <typename TransFunc, bool = has_uniform<TransFunc>::value> struct FunctionUniform {
+        struct type {};
+    };
+
+    template <typename TransFunc> struct FunctionUniform<TransFunc, true> {
+        using type = typename TransFunc::Uniform;
+    };
+
+    template <typename... Funcs> struct UniformList {};
+
+    template <typename Func, typename... Funcs> struct UniformList<Func, Funcs...> {
+        typename FunctionUniform<Func>::type head;
+        UniformList<Funcs...> tail;
+    };
+
+  public:
+    /**
+     * \brief The uniforms of the sequence.
+     *
+     * It contains one entry for every function of the sequence, which is empty if the function
+     * doesn't declare uniforms. Only the entry of the function that computes the generation is set.
+     */
+    using Uniform = UniformList<TransFuncs...>;
+
+    /**
+     * \brief Create a new sequence from default-constructed transition functions.
+     */
+    TransFuncSequence() : trans_funcs() {}
+
+    /**
+     * \brief Create a new sequence from transition function instances.
+     *
+     * \param trans_funcs The instances of the transition functions, in the order of their
+     * application.
+     */
+    TransFuncSequence(TransFuncs... trans_funcs) : trans_funcs(trans_funcs...) {}
+
+    /**
+     * \brief Get the index of the function that is applied by a pipeline stage.
+     */
+    static constexpr uindex_t get_function_index(uindex_t stage) { return stage % n_functions; }
+
+    /**
+     * \brief Check whether any function of the sequence may read a stencil cell.
+     *
+     * Functions that do not declare an access set may read every cell. See \ref StencilAccessSet
+     * for details.
+     */
+    static constexpr bool accesses(index_t c, index_t r) {
+        return (function_accesses<TransFuncs>(c, r) || ...);
+    }
+
+    /**
+     * \brief Get a transition function instance of the sequence.
+     *
+     * \tparam i The index of the function.
+     */
+    template <uindex_t i> auto &get() { return std::get<i>(trans_funcs); }
+
+    /**
+     * \brief Get a transition function instance of the sequence.
+     *
+     * \tparam i The index of the function.
+     */
+    template <uindex_t i> auto const &get() const { return std::get<i>(trans_funcs); }
+
+    /**
+     * \brief Compute the uniform of the function that computes a generation.
+     *
+     * \param i_generation The index of the generation that is computed.
+     */
+    Uniform get_uniform(uindex_t i_generation) const {
+        Uniform uniform;
+        fill_uniform<0>(uniform, i_generation);
+        return uniform;
+    }
+
+    /**
+     * \brief Apply the function of the stencil's pipeline stage.
+     *
+     * This is only possible if none of the functions declares uniforms.
+     */
+    template <typename T, uindex_t stencil_radius>
+    T operator()(Stencil<T, stencil_radius> const &stencil) const {
+        return apply<0>(stencil, Uniform());
+    }
+
+    /**
+     * \brief Apply the function of the stencil's pipeline stage with its uniform.
+     */
+    template <typename T, uindex_t stencil_radius>
+    T operator()(Stencil<T, stencil_radius> const &stencil, Uniform const &uniform) const {
+        return apply<0>(stencil, uniform);
+    }
+
+  private:
+    template <typename TransFunc> static constexpr bool function_accesses(index_t c, index_t r) {
+        if constexpr (has_access_set<TransFunc>::value) {
+            return TransFunc::accesses(c, r);
+        } else {
+            return true;
+        }
+    }
+
+    template <uindex_t i, typename List> static auto const &get_entry(List const &list) {
+        if constexpr (i == 0) {
+            return list.head;
+        } else {
+            return get_entry<i - 1>(list.tail);
+        }
+    }
+
+    template <uindex_t i, typename List>
+    void fill_uniform(List &list, uindex_t i_generation) const {
+        if constexpr (i < n_functions) {
+            using TransFunc = std::tuple_element_t<i, std::tuple<TransFuncs...>>;
+            // Passes start with a multiple of the sequence length, so the generation index selects
+            // the same function as the stage index.
+            if constexpr (has_uniform<TransFunc>::value) {
+                if (i_generation % n_functions == i) {
+                    list.head = std::get<i>(trans_funcs).get_uniform(i_generation);
+                }
+            }
+            fill_uniform<i + 1>(list.tail, i_generation);
+        }
+    }
+
+    template <uindex_t i, typename T, uindex_t stencil_radius>
+    T call(Stencil<T, stencil_radius> const &stencil, Uniform const &uniform) const {
+        using TransFunc = std::tuple_element_t<i, std::tuple<TransFuncs...>>;
+        if constexpr (has_uniform<TransFunc>::value) {
+            return std::get<i>(trans_funcs)(stencil, get_entry<i>(uniform));
+        } else {
+            return std::get<i>(trans_funcs)(stencil);
+        }
+    }
+
+    template <uindex_t i, typename T, uindex_t stencil_radius>
+    T apply(Stencil<T, stencil_radius> const &stencil, Uniform const &uniform) const {
+        if constexpr (i == n_functions - 1) {
+            return call<i>(stencil, uniform);
+        } else {
+            if (get_function_index(stencil.stage) == i) {
+                return call<i>(stencil, uniform);
+            } else {
+                return apply<i + 1>(stencil, uniform);
+            }
+        }
+    }
+
+    std::tuple<TransFuncs...> trans_funcs;
+};
+} // namespace stencil
@@ -0,0 +1,140 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Index.hpp"
+#include "Stencil.hpp"
+#include <type_traits>
+
+namespace stencil {
+/**
+ * \brief Check whether a transition function declares per-generation uniforms.
+ *
+ * This is the case if the transition function type has a member type `Uniform`. See \ref
+ * UniformTable for the complete interface.
+ */
+template <typename TransFunc, typename = void> struct has_uniform : std::false_type {};
+
+template <typename TransFunc>
+struct has_uniform<TransFunc, std::void_t<typename TransFunc::Uniform>> : std::true_type {};
+
+/**
+ * \brief The per-stage uniforms of an execution kernel invocation.
+ *
+ * Some values used by a transition function only depend on the generation index, like the current
+ * time of a simulation or the amplitude of a source. Instead of computing them for every cell, a
+ * transition function may declare them as uniforms by providing the following members:
+ * ```
+ * struct Uniform { ... };
+ * Uniform get_uniform(uindex_t i_generation) const;
+ * T operator()(Stencil<T, stencil_radius> const &stencil, Uniform const &uniform) const;
+ * ```
+ * The execution kernels store a table with one uniform for each pipeline stage. It is filled on the
+ * host when the kernel is constructed, which happens once per kernel submission, and the stages
+ * pass their entry to the transition function. The monotile executor submits one execution kernel
+ * per pass, while the tiling executors submit one per tile and pass. Since the stage index is hard
+ * coded in the final design, every entry is a constant of its stage and no per-cell computations
+ * are required. The `Uniform` type has to be default-constructible and trivially copyable.
+ *
+ * Transition functions without a `Uniform` type are called with the stencil only and the table is
+ * empty.
+ *
+ * \tparam TransFunc The type of the transition function.
+ * \tparam pipeline_length The number of pipeline stages.
+ */
+template <typename TransFunc, uindex_t pipeline_length,
+          bool enabled = has_uniform<TransFunc>::value>
+class UniformTable {
+  public:
+    /**
+     * \brief Check whether the transition function can be applied to stencils of the given type.
+     */
+    template <typename T, uindex_t stencil_radius>
+    static constexpr bool is_applicable =
+        std::is_invocable_r<T, TransFunc const, Stencil<T, stencil_radius> const &>::value;
+
+    /**
+     * \brief Create an empty table.
+     */
+    UniformTable(TransFunc const &trans_func, uindex_t i_generation,
+                 uindex_t target_i_generation) {}
+
+    /**
+     * \brief Apply the transition function to the stencil.
+     */
+    template <typename T, uindex_t stencil_radius>
+    T apply(TransFunc const &trans_func, Stencil<T, stencil_radius> const &stencil) const {
+        return trans_func(stencil);
+    }
+};
+
+template <typename TransFunc, uindex_t pipeline_length>
+class UniformTable<TransFunc, pipeline_length, true> {
+  public:
+    /**
+     * \brief The type of the uniforms.
+     */
+    using Uniform = typename TransFunc::Uniform;
+
+    static_assert(std::is_trivially_copyable<Uniform>::value);
+
+    /**
+     * \brief Check whether the transition function can be applied to stencils of the given type.
+     */
+    template <typename T, uindex_t stencil_radius>
+    static constexpr bool is_applicable =
+        std::is_invocable_r<T, TransFunc const, Stencil<T, stencil_radius> const &,
+                            Uniform const &>::value;
+
+    /**
+     * \brief Compute the uniforms of all stages on the host.
+     *
+     * The uniforms of stages that compute a generation index beyond `target_i_generation` are
+     * default-constructed, since these stages do not call the transition function.
+     *
+     * \param trans_func The transition function instance that computes the uniforms.
+     * \param i_generation The generation index of the input cells of the first stage.
+     * \param target_i_generation The generation index that the pipeline computes.
+     */
+    UniformTable(TransFunc const &trans_func, uindex_t i_generation, uindex_t target_i_generation)
+        : uniforms() {
+        for (uindex_t stage = 0; stage < pipeline_length; stage++) {
+            if (i_generation + stage < target_i_generation) {
+                uniforms[stage] = trans_func.get_uniform(i_generation + stage);
+            }
+        }
+    }
+
+    /**
+     * \brief Get the uniform of a pipeline stage.
+     */
+    Uniform const &operator[](uindex_t stage) const { return uniforms[stage]; }
+
+    /**
+     * \brief Apply the transition function to the stencil with the uniform of the stencil's stage.
+     */
+    template <typename T, uindex_t stencil_radius>
+    T apply(TransFunc const &trans_func, Stencil<T, stencil_radius> const &stencil) const {
+        return trans_func(stencil, uniforms[stencil.stage]);
+    }
+
+  private:
+    Uniform uniforms[pipeline_length];
+};
+} // namespace stencil
@@ -21,12 +21,24 @@
 #include "../GenericID.hpp"
 #include "../Helpers.hpp"
 #include "../Index.hpp"
+#include "../Reduction.hpp"
+#include "../ResourceEstimate.hpp"
 #include "../Stencil.hpp"
+#include "../UniformTable.hpp"
 #include <optional>
 
 namespace stencil {
 namespace monotile {
 
+/**
+ * \brief The number of bits of the per-stage column, row, parity and tile counters of the \ref
+ * ExecutionKernel.
+ *
+ * It does not depend on the kernel's template parameters, so that the \ref
+ * MonotilePerformanceModel can use it without instantiating the kernel.
+ */
+constexpr uindex_t n_counter_bits_per_stage = 16 * sizeof(index_t) + 1 + 8 * sizeof(uindex_t);
+
 /**
  * \brief A kernel that executes a stencil transition function using the monotile approach.
  *
@@ -37,6 +49,11 @@ namespace monotile {
  * calculate the cells of the tile halo, reducing the cache size and number of loop iterations. More
  * is described in \ref monotile.
  *
+ * The kernel may also process a batch of independent tiles in one invocation. The tiles are read
+ * from the `in_pipe` back-to-back and the pipeline is only filled once for the whole batch. Since
+ * the column counters are tile-local, cells of neighboring tiles in the stream are never visible to
+ * each other: They are outside of the grid and are therefore replaced with the halo value.
+ *
  * \tparam TransFunc The type of transition function to use.
  * \tparam T Cell value type.
  * \tparam stencil_radius The static, maximal Chebyshev distance of cells in a stencil to the
@@ -49,9 +66,19 @@ template <typename TransFunc, typename T, uindex_t stencil_radius, uindex_t pipe
           uindex_t tile_width, uindex_t tile_height, typename in_pipe, typename out_pipe>
 class ExecutionKernel {
   public:
-    static_assert(
-        std::is_invocable_r<T, TransFunc const, Stencil<T, stencil_radius> const &>::value);
+    /**
+     * \brief The type of the table with the per-stage uniforms of the transition function.
+     */
+    using UniformTableImpl = UniformTable<TransFunc, pipeline_length>;
+
+    /**
+     * \brief The set of stencil cells that is read by the transition function.
+     */
+    using AccessSet = StencilAccessSet<TransFunc, stencil_radius>;
+
+    static_assert(UniformTableImpl::template is_applicable<T, stencil_radius>);
     static_assert(stencil_radius >= 1);
+    static_assert(pipeline_length % stage_period<TransFunc>::value == 0);
 
     /**
      * \brief The width and height of the stencil buffer.
@@ -76,10 +103,22 @@ class ExecutionKernel {
     const static uindex_t pipeline_latency = pipeline_length * stage_latency;
 
     /**
-     * \brief The total number of loop iterations.
+     * \brief The total number of loop iterations for a single tile.
      */
     const static uindex_t n_iterations = pipeline_latency + n_cells;
 
+    /**
+     * \brief The number of bits of the per-stage column, row, parity and tile counters.
+     */
+    const static uindex_t n_counter_bits_per_stage = monotile::n_counter_bits_per_stage;
+
+    /**
+     * \brief The estimated on-chip resources of the cache, the stencil buffers and the counters.
+     */
+    static constexpr ResourceEstimate resource_estimate =
+        ResourceEstimate::estimate<T, stencil_radius, pipeline_length>(tile_height,
+                                                                       n_counter_bits_per_stage);
+
     /**
      * \brief Create and configure the execution kernel.
      *
@@ -90,19 +129,56 @@ class ExecutionKernel {
      * \param grid_width The number of cell columns in the grid.
      * \param grid_height The number of cell rows in the grid.
      * \param halo_value The value of cells outside the grid.
+     * \param n_tiles The number of independent tiles to read from the `in_pipe`. All tiles are
+     * processed with the same grid range and generation indices. Defaults to 1.
      */
     ExecutionKernel(TransFunc trans_func, uindex_t i_generation, uindex_t n_generations,
-                    uindex_t grid_width, uindex_t grid_height, T halo_value)
-        : trans_func(trans_func), i_generation(i_generation), n_generations(n_generations),
-          grid_width(grid_width), grid_height(grid_height), halo_value(halo_value) {}
+                    uindex_t grid_width, uindex_t grid_height, T halo_value, uindex_t n_tiles = 1)
+        : trans_func(trans_func), uniforms(trans_func, i_generation, n_generations),
+          i_generation(i_generation), n_generations(n_generations), grid_width(grid_width),
+          grid_height(grid_height), halo_value(halo_value), n_tiles(n_tiles) {}
 
     /**
      * \brief Execute the kernel.
      */
-    void operator()() const {
+    void operator()() const { run(NoReduction()); }
+
+    /**
+     * \brief Execute the kernel and reduce the changes of the grid's cells.
+     *
+     * Every cell of the grid is mapped with the reduction when the last computing stage of the pass
+     * updates it, which is when the stage has both the cell's previous value (the center of its
+     * stencil) and its new value. Therefore, the reduced value describes the difference between the
+     * last two generations of the pass, and no additional memory accesses are needed. If the kernel
+     * processes a batch of tiles, the cells of all tiles are reduced to one value. If no generation
+     * is computed, the identity of the reduction is returned.
+     *
+     * \tparam Reduction The type of the reduction. See \ref MaxAbsDifference for the requirements.
+     * \param reduction The reduction to use.
+     * \return The reduced value of the grid's cells.
+     */
+    template <typename Reduction>
+    typename Reduction::Value operator()(Reduction const &reduction) const {
+        return run(reduction);
+    }
+
+  private:
+    template <typename Reduction>
+    typename Reduction::Value run(Reduction const &reduction) const {
+        typename Reduction::Value reduced = reduction.identity();
+
         [[intel::fpga_register]] index_t c[pipeline_length];
         [[intel::fpga_register]] index_t r[pipeline_length];
 
+        /*
+         * The column counters are tile-local and are reset when the next tile of a batch starts.
+         * The cache however needs to alternate between its two halves with every column, which is
+         * why the parity of the column is tracked separately. The tile counters are used to detect
+         * the cells after the last tile, which are outside of every grid.
+         */
+        [[intel::fpga_register]] bool c_parity[pipeline_length];
+        [[intel::fpga_register]] uindex_t i_tile[pipeline_length];
+
         // Initializing (output) column and row counters.
         index_t prev_c = 0;
         index_t prev_r = 0;
@@ -114,6 +190,8 @@ class ExecutionKernel {
                 r[i] += tile_height;
                 c[i] -= 1;
             }
+            c_parity[i] = c[i] & 0b1;
+            i_tile[i] = 0;
             prev_c = c[i];
             prev_r = r[i];
         }
@@ -130,9 +208,12 @@ class ExecutionKernel {
         [[intel::fpga_register]] T stencil_buffer[pipeline_length][stencil_diameter]
                                                  [stencil_diameter];
 
-        for (uindex_t i = 0; i < n_iterations; i++) {
+        uindex_t n_input_cells = n_tiles * n_cells;
+        uindex_t n_batch_iterations = pipeline_latency + n_input_cells;
+
+        for (uindex_t i = 0; i < n_batch_iterations; i++) {
             T value;
-            if (i < n_cells) {
+            if (i < n_input_cells) {
                 value = in_pipe::read();
             } else {
                 value = halo_value;
@@ -144,7 +225,9 @@ class ExecutionKernel {
                 for (uindex_t r = 0; r < stencil_diameter - 1; r++) {
 #pragma unroll
                     for (uindex_t c = 0; c < stencil_diameter; c++) {
-                        stencil_buffer[stage][c][r] = stencil_buffer[stage][c][r + 1];
+                        if (AccessSet::is_stored(c, r)) {
+                            stencil_buffer[stage][c][r] = stencil_buffer[stage][c][r + 1];
+                        }
                     }
                 }
 
@@ -156,17 +239,19 @@ class ExecutionKernel {
                     if (cache_c == stencil_diameter - 1) {
                         new_value = value;
                     } else {
-                        new_value = cache[c[stage] & 0b1][r[stage]][stage][cache_c];
+                        new_value = cache[c_parity[stage]][r[stage]][stage][cache_c];
                     }
 
-                    stencil_buffer[stage][cache_c][stencil_diameter - 1] = new_value;
+                    if (AccessSet::is_stored(cache_c, stencil_diameter - 1)) {
+                        stencil_buffer[stage][cache_c][stencil_diameter - 1] = new_value;
+                    }
                     if (cache_c > 0) {
-                        cache[(~c[stage]) & 0b1][r[stage]][stage][cache_c - 1] = new_value;
+                        cache[!c_parity[stage]][r[stage]][stage][cache_c - 1] = new_value;
                     }
                 }
 
                 if (i_generation + stage < n_generations) {
-                    if (id_in_grid(c[stage], r[stage])) {
+                    if (i_tile[stage] < n_tiles && id_in_grid(c[stage], r[stage])) {
                         Stencil<T, stencil_radius> stencil(ID(c[stage], r[stage]),
                                                            i_generation + stage, stage,
                                                            UID(grid_width, grid_height));
@@ -177,6 +262,11 @@ class ExecutionKernel {
 #pragma unroll
                             for (index_t cell_r = -stencil_radius;
                                  cell_r <= index_t(stencil_radius); cell_r++) {
+                                if (!AccessSet::is_read(cell_c + stencil_radius,
+                                                        cell_r + stencil_radius)) {
+                                    continue;
+                                }
+
                                 if (id_in_grid(cell_c + c[stage], cell_r + r[stage])) {
                                     stencil[ID(cell_c, cell_r)] =
                                         stencil_buffer[stage][cell_c + stencil_radius]
@@ -187,7 +277,17 @@ class ExecutionKernel {
                             }
                         }
 
-                        value = trans_func(stencil);
+                        T new_value = uniforms.apply(trans_func, stencil);
+
+                        if (stage == pipeline_length - 1 ||
+                            i_generation + stage + 1 == n_generations) {
+                            reduced = reduction.combine(
+                                reduced,
+                                reduction.map(stencil_buffer[stage][stencil_radius][stencil_radius],
+                                              new_value));
+                        }
+
+                        value = new_value;
                     } else {
                         value = halo_value;
                     }
@@ -198,7 +298,13 @@ class ExecutionKernel {
                 r[stage] += 1;
                 if (r[stage] == tile_height) {
                     r[stage] = 0;
-                    c[stage] += 1;
+                    c_parity[stage] = !c_parity[stage];
+                    if (c[stage] == index_t(tile_width) - 1) {
+                        c[stage] = 0;
+                        i_tile[stage] += 1;
+                    } else {
+                        c[stage] += 1;
+                    }
                 }
             }
 
@@ -206,20 +312,23 @@ class ExecutionKernel {
                 out_pipe::write(value);
             }
         }
+
+        return reduced;
     }
 
-  private:
     bool id_in_grid(index_t c, index_t r) const {
         return c >= index_t(0) && r >= index_t(0) && c < index_t(grid_width) &&
                r < index_t(grid_height);
     }
 
     TransFunc trans_func;
+    UniformTableImpl uniforms;
     uindex_t i_generation;
     uindex_t n_generations;
     uindex_t grid_width;
     uindex_t grid_height;
     T halo_value;
+    uindex_t n_tiles;
 };
 
 } // namespace monotile
@@ -0,0 +1,330 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "../GenericID.hpp"
+#include "../Helpers.hpp"
+#include "../Index.hpp"
+#include "../ResourceEstimate.hpp"
+#include "../Stencil.hpp"
+#include "../UniformTable.hpp"
+#include <cassert>
+
+namespace stencil {
+namespace skewed {
+
+/**
+ * \brief A vector with one cell value for every pipeline stage that reads a strip.
+ *
+ * \tparam T The cell type.
+ * \tparam pipeline_length The number of pipeline stages.
+ */
+template <typename T, uindex_t pipeline_length> struct Strip {
+    /**
+     * \brief The number of values in a strip vector. Stage 0 reads the grid instead of a strip,
+     * but the vector has at least one value.
+     */
+    static constexpr uindex_t n_values = pipeline_length > 1 ? pipeline_length - 1 : 1;
+
+    /**
+     * \brief The values of the stages 1 to `pipeline_length - 1`.
+     */
+    T values[n_values];
+};
+
+/**
+ * \brief A kernel that executes a stencil transition function on a skewed tile.
+ *
+ * Unlike \ref tiling::ExecutionKernel, this kernel does not recompute a halo around the tile.
+ * Instead, the pipeline stages are skewed: Stage `s` works on a window that is shifted by
+ * `(s + 2) * stencil_radius` cells to the north and west of the tile's origin, and the last stage
+ * outputs the tile shifted by `pipeline_length * stencil_radius` cells. The input window of every
+ * stage is only `2 * stencil_radius` cells wider and higher than the tile. Its main part is the
+ * output of the previous stage, while its western and northern strips, which would require cells
+ * of the neighboring tiles, are read from the `strip_in_pipe`. In turn, the stage outputs in the
+ * eastern and southern strips of the tile are written to the `strip_out_pipe`, so that the tiles to
+ * the east and south can read them. Therefore, every intermediate cell is computed exactly once,
+ * but the tiles have to be processed in column-major order.
+ *
+ * The kernel iterates over the `(n_columns + 2 * stencil_radius) x (n_rows + 2 * stencil_radius)`
+ * window positions in column-major order, where `n_columns` and `n_rows` are the range of the
+ * output tile, which may be smaller than the static tile range at the grid's borders. In every
+ * iteration, it reads a cell of the input grid for stage 0 from the `in_pipe`, and, if the position
+ * is in the western or northern strip, a \ref Strip with the inputs of the other stages from the
+ * `strip_in_pipe`. If the position is not in one of these strips, the last stage writes a cell to
+ * the `out_pipe`, and if it is in the eastern or southern strip too, the outputs of all other
+ * stages are written as a \ref Strip to the `strip_out_pipe`. If the pipeline has a single stage,
+ * no strips are transferred.
+ *
+ * \tparam TransFunc The type of transition function to use.
+ * \tparam T Cell value type.
+ * \tparam stencil_radius The static, maximal Chebyshev distance of cells in a stencil to the
+ * central cell.
+ * \tparam pipeline_length The number of pipeline stages to use.
+ * \tparam tile_width The maximal number of columns in a grid tile.
+ * \tparam tile_height The maximal number of rows in a grid tile.
+ * \tparam in_pipe The pipe to read the input cells from.
+ * \tparam out_pipe The pipe to write the output cells to.
+ * \tparam strip_in_pipe The pipe to read the strip vectors from.
+ * \tparam strip_out_pipe The pipe to write the strip vectors to.
+ */
+template <typename TransFunc, typename T, uindex_t stencil_radius, uindex_t pipeline_length,
+          uindex_t tile_width, uindex_t tile_height, typename in_pipe, typename out_pipe,
+          typename strip_in_pipe, typename strip_out_pipe>
+class ExecutionKernel {
+  public:
+    /**
+     * \brief The type of the table with the per-stage uniforms of the transition function.
+     */
+    using UniformTableImpl = UniformTable<TransFunc, pipeline_length>;
+
+    /**
+     * \brief The set of stencil cells that is read by the transition function.
+     */
+    using AccessSet = StencilAccessSet<TransFunc, stencil_radius>;
+
+    /**
+     * \brief The type of the strip vectors.
+     */
+    using StripImpl = Strip<T, pipeline_length>;
+
+    static_assert(UniformTableImpl::template is_applicable<T, stencil_radius>);
+    static_assert(stencil_radius >= 1);
+    static_assert(pipeline_length % stage_period<TransFunc>::value == 0);
+    static_assert(pipeline_length >= 1);
+    static_assert(tile_width >= 2 * stencil_radius && tile_height >= 2 * stencil_radius);
+
+    /**
+     * \brief The width and height of the stencil buffer.
+     */
+    static constexpr uindex_t stencil_diameter = Stencil<T, stencil_radius>::diameter;
+
+    /**
+     * \brief The width of the western/eastern strips and the height of the northern/southern
+     * strips.
+     */
+    static constexpr uindex_t strip_width = 2 * stencil_radius;
+
+    /**
+     * \brief The maximal width of the input window of a stage.
+     */
+    static constexpr uindex_t input_tile_width = tile_width + strip_width;
+
+    /**
+     * \brief The maximal height of the input window of a stage.
+     */
+    static constexpr uindex_t input_tile_height = tile_height + strip_width;
+
+    /**
+     * \brief The estimated on-chip resources of the cache and the stencil buffers.
+     */
+    static constexpr ResourceEstimate resource_estimate =
+        ResourceEstimate::estimate<T, stencil_radius, pipeline_length>(input_tile_height);
+
+    /**
+     * \brief Check whether a window position is in the western or northern strip.
+     *
+     * The inputs of stage 1 and above are read from the `strip_in_pipe` for these positions.
+     */
+    static constexpr bool is_strip_input(uindex_t c, uindex_t r) {
+        return c < strip_width || r < strip_width;
+    }
+
+    /**
+     * \brief Check whether the stage outputs at a window position are valid cells of the tile.
+     */
+    static constexpr bool is_output(uindex_t c, uindex_t r) {
+        return c >= strip_width && r >= strip_width;
+    }
+
+    /**
+     * \brief Check whether the stage outputs at a window position are written to the
+     * `strip_out_pipe`.
+     *
+     * This is the case for the valid outputs in the eastern and southern strips of a tile with the
+     * static tile range. Tiles at the grid's eastern and southern borders may be too small to
+     * reach them, but they don't have neighbors in these directions either.
+     */
+    static constexpr bool is_strip_output(uindex_t c, uindex_t r) {
+        return is_output(c, r) && (c >= tile_width || r >= tile_height);
+    }
+
+    /**
+     * \brief Create and configure the execution kernel.
+     *
+     * \param trans_func The instance of the transition function to use.
+     * \param i_generation The generation index of the input cells.
+     * \param target_i_generation The generation index to compute. If it is more than
+     * `pipeline_length` generations ahead, only `pipeline_length` generations will be computed.
+     * \param tile_c_offset The column offset of the unskewed tile relative to the grid's origin.
+     * The tile that is output by the kernel starts `pipeline_length * stencil_radius` columns to
+     * the west of it.
+     * \param tile_r_offset The row offset of the unskewed tile relative to the grid's origin.
+     * \param n_columns The number of columns of the output tile. Must not exceed `tile_width`.
+     * \param n_rows The number of rows of the output tile. Must not exceed `tile_height`.
+     * \param grid_width The number of cell columns in the grid.
+     * \param grid_height The number of cell rows in the grid.
+     * \param halo_value The value of cells in the grid halo.
+     */
+    ExecutionKernel(TransFunc trans_func, uindex_t i_generation, uindex_t target_i_generation,
+                    uindex_t tile_c_offset, uindex_t tile_r_offset, uindex_t n_columns,
+                    uindex_t n_rows, uindex_t grid_width, uindex_t grid_height, T halo_value)
+        : trans_func(trans_func), uniforms(trans_func, i_generation, target_i_generation),
+          i_generation(i_generation), target_i_generation(target_i_generation),
+          tile_c_offset(tile_c_offset), tile_r_offset(tile_r_offset), n_columns(n_columns),
+          n_rows(n_rows), grid_width(grid_width), grid_height(grid_height),
+          halo_value(halo_value) {
+#ifndef __SYCL_DEVICE_ONLY__
+        assert(n_columns <= tile_width && n_rows <= tile_height);
+#endif
+    }
+
+    /**
+     * \brief Execute the configured operations.
+     */
+    void operator()() const {
+        uindex_t input_tile_c = 0;
+        uindex_t input_tile_r = 0;
+        uindex_t n_input_rows = n_rows + strip_width;
+        uindex_t n_input_cells = (n_columns + strip_width) * n_input_rows;
+
+        /*
+         * See tiling::ExecutionKernel for the reason for the power of two. Other than in the
+         * tiling kernel, every stage only caches the window of the skewed tile.
+         */
+        [[intel::fpga_memory, intel::numbanks(2 * next_power_of_two(pipeline_length))]] T
+            cache[2][input_tile_height][next_power_of_two(pipeline_length)][stencil_diameter - 1];
+        [[intel::fpga_register]] T stencil_buffer[pipeline_length][stencil_diameter]
+                                                 [stencil_diameter];
+
+        for (uindex_t i = 0; i < n_input_cells; i++) {
+            T value = in_pipe::read();
+
+            bool is_strip_input_position = is_strip_input(input_tile_c, input_tile_r);
+            StripImpl strip_in;
+            StripImpl strip_out;
+            if constexpr (pipeline_length > 1) {
+                if (is_strip_input_position) {
+                    strip_in = strip_in_pipe::read();
+                }
+            }
+
+#pragma unroll
+            for (uindex_t stage = 0; stage < pipeline_length; stage++) {
+                if (stage > 0 && is_strip_input_position) {
+                    value = strip_in.values[stage - 1];
+                }
+
+#pragma unroll
+                for (uindex_t r = 0; r < stencil_diameter - 1; r++) {
+#pragma unroll
+                    for (uindex_t c = 0; c < stencil_diameter; c++) {
+                        if (AccessSet::is_stored(c, r)) {
+                            stencil_buffer[stage][c][r] = stencil_buffer[stage][c][r + 1];
+                        }
+                    }
+                }
+
+                index_t input_grid_c = index_t(tile_c_offset) + index_t(input_tile_c) -
+                                       index_t((stage + 2) * stencil_radius);
+                index_t input_grid_r = index_t(tile_r_offset) + index_t(input_tile_r) -
+                                       index_t((stage + 2) * stencil_radius);
+
+#pragma unroll
+                for (uindex_t cache_c = 0; cache_c < stencil_diameter; cache_c++) {
+                    T new_value;
+                    if (cache_c == stencil_diameter - 1) {
+                        if (input_grid_c < 0 || input_grid_r < 0 || input_grid_c >= grid_width ||
+                            input_grid_r >= grid_height) {
+                            new_value = halo_value;
+                        } else {
+                            new_value = value;
+                        }
+                    } else {
+                        new_value = cache[input_tile_c & 0b1][input_tile_r][stage][cache_c];
+                    }
+
+                    if (AccessSet::is_stored(cache_c, stencil_diameter - 1)) {
+                        stencil_buffer[stage][cache_c][stencil_diameter - 1] = new_value;
+                    }
+                    if (cache_c > 0) {
+                        cache[(~input_tile_c) & 0b1][input_tile_r][stage][cache_c - 1] = new_value;
+                    }
+                }
+
+                index_t output_grid_c = input_grid_c - stencil_radius;
+                index_t output_grid_r = input_grid_r - stencil_radius;
+                Stencil<T, stencil_radius> stencil(ID(output_grid_c, output_grid_r),
+                                                   i_generation + stage, stage,
+                                                   UID(grid_width, grid_height));
+#pragma unroll
+                for (uindex_t c = 0; c < stencil_diameter; c++) {
+#pragma unroll
+                    for (uindex_t r = 0; r < stencil_diameter; r++) {
+                        if (AccessSet::is_read(c, r)) {
+                            stencil[UID(c, r)] = stencil_buffer[stage][c][r];
+                        }
+                    }
+                }
+
+                if (i_generation + stage < target_i_generation) {
+                    value = uniforms.apply(trans_func, stencil);
+                } else {
+                    value = stencil_buffer[stage][stencil_radius][stencil_radius];
+                }
+
+                if (stage < pipeline_length - 1) {
+                    strip_out.values[stage] = value;
+                }
+            }
+
+            if (is_output(input_tile_c, input_tile_r)) {
+                out_pipe::write(value);
+            }
+            if constexpr (pipeline_length > 1) {
+                if (is_strip_output(input_tile_c, input_tile_r)) {
+                    strip_out_pipe::write(strip_out);
+                }
+            }
+
+            if (input_tile_r == n_input_rows - 1) {
+                input_tile_r = 0;
+                input_tile_c++;
+            } else {
+                input_tile_r++;
+            }
+        }
+    }
+
+  private:
+    TransFunc trans_func;
+    UniformTableImpl uniforms;
+    uindex_t i_generation;
+    uindex_t target_i_generation;
+    uindex_t tile_c_offset;
+    uindex_t tile_r_offset;
+    uindex_t n_columns;
+    uindex_t n_rows;
+    uindex_t grid_width;
+    uindex_t grid_height;
+    T halo_value;
+};
+
+} // namespace skewed
+} // namespace stencil
@@ -21,7 +21,10 @@
 #include "../GenericID.hpp"
 #include "../Helpers.hpp"
 #include "../Index.hpp"
+#include "../Reduction.hpp"
+#include "../ResourceEstimate.hpp"
 #include "../Stencil.hpp"
+#include "../UniformTable.hpp"
 #include <optional>
 
 namespace stencil {
@@ -49,9 +52,19 @@ template <typename TransFunc, typename T, uindex_t stencil_radius, uindex_t pipe
           typename out_pipe>
 class ExecutionKernel {
   public:
-    static_assert(
-        std::is_invocable_r<T, TransFunc const, Stencil<T, stencil_radius> const &>::value);
+    /**
+     * \brief The type of the table with the per-stage uniforms of the transition function.
+     */
+    using UniformTableImpl = UniformTable<TransFunc, pipeline_length>;
+
+    /**
+     * \brief The set of stencil cells that is read by the transition function.
+     */
+    using AccessSet = StencilAccessSet<TransFunc, stencil_radius>;
+
+    static_assert(UniformTableImpl::template is_applicable<T, stencil_radius>);
     static_assert(stencil_radius >= 1);
+    static_assert(pipeline_length % stage_period<TransFunc>::value == 0);
 
     /**
      * \brief The width and height of the stencil buffer.
@@ -77,6 +90,12 @@ class ExecutionKernel {
     const static uindex_t input_tile_height =
         2 * stencil_radius * pipeline_length + output_tile_height;
 
+    /**
+     * \brief The estimated on-chip resources of the cache and the stencil buffers.
+     */
+    static constexpr ResourceEstimate resource_estimate =
+        ResourceEstimate::estimate<T, stencil_radius, pipeline_length>(input_tile_height);
+
     /**
      * \brief Create and configure the execution kernel.
      *
@@ -96,7 +115,8 @@ class ExecutionKernel {
     ExecutionKernel(TransFunc trans_func, uindex_t i_generation, uindex_t target_i_generation,
                     uindex_t grid_c_offset, uindex_t grid_r_offset, uindex_t grid_width,
                     uindex_t grid_height, T halo_value)
-        : trans_func(trans_func), i_generation(i_generation),
+        : trans_func(trans_func), uniforms(trans_func, i_generation, target_i_generation),
+          i_generation(i_generation),
           target_i_generation(target_i_generation), grid_c_offset(grid_c_offset),
           grid_r_offset(grid_r_offset), grid_width(grid_width), grid_height(grid_height),
           halo_value(halo_value) {}
@@ -104,7 +124,31 @@ class ExecutionKernel {
     /**
      * \brief Execute the configured operations.
      */
-    void operator()() const {
+    void operator()() const { run(NoReduction()); }
+
+    /**
+     * \brief Execute the configured operations and reduce the changes of the tile's cells.
+     *
+     * Every cell of the tile is mapped with the reduction when the last computing stage of the
+     * pass updates it, which is when the stage has both the cell's previous value (the center of
+     * its stencil) and its new value. Therefore, the reduced value describes the difference between
+     * the last two generations of the pass, and no additional memory accesses are needed. Cells of
+     * the tile halo and cells outside of the grid are not mapped. If no generation is computed, the
+     * identity of the reduction is returned.
+     *
+     * \tparam Reduction The type of the reduction. See \ref MaxAbsDifference for the requirements.
+     * \param reduction The reduction to use.
+     * \return The reduced value of the tile's cells.
+     */
+    template <typename Reduction>
+    typename Reduction::Value operator()(Reduction const &reduction) const {
+        return run(reduction);
+    }
+
+  private:
+    template <typename Reduction>
+    typename Reduction::Value run(Reduction const &reduction) const {
+        typename Reduction::Value reduced = reduction.identity();
         uindex_t input_tile_c = 0;
         uindex_t input_tile_r = 0;
 
@@ -134,7 +178,9 @@ class ExecutionKernel {
                 for (uindex_t r = 0; r < stencil_diameter - 1; r++) {
 #pragma unroll
                     for (uindex_t c = 0; c < stencil_diameter; c++) {
-                        stencil_buffer[stage][c][r] = stencil_buffer[stage][c][r + 1];
+                        if (AccessSet::is_stored(c, r)) {
+                            stencil_buffer[stage][c][r] = stencil_buffer[stage][c][r + 1];
+                        }
                     }
                 }
 
@@ -161,7 +207,9 @@ class ExecutionKernel {
                         new_value = cache[input_tile_c & 0b1][input_tile_r][stage][cache_c];
                     }
 
-                    stencil_buffer[stage][cache_c][stencil_diameter - 1] = new_value;
+                    if (AccessSet::is_stored(cache_c, stencil_diameter - 1)) {
+                        stencil_buffer[stage][cache_c][stencil_diameter - 1] = new_value;
+                    }
                     if (cache_c > 0) {
                         cache[(~input_tile_c) & 0b1][input_tile_r][stage][cache_c - 1] = new_value;
                     }
@@ -169,12 +217,39 @@ class ExecutionKernel {
 
                 index_t output_grid_c = input_grid_c - stencil_radius;
                 index_t output_grid_r = input_grid_r - stencil_radius;
-                Stencil<T, stencil_radius> stencil(
-                    ID(output_grid_c, output_grid_r), i_generation + stage, stage,
-                    stencil_buffer[stage], UID(grid_width, grid_height));
+                Stencil<T, stencil_radius> stencil(ID(output_grid_c, output_grid_r),
+                                                   i_generation + stage, stage,
+                                                   UID(grid_width, grid_height));
+#pragma unroll
+                for (uindex_t c = 0; c < stencil_diameter; c++) {
+#pragma unroll
+                    for (uindex_t r = 0; r < stencil_diameter; r++) {
+                        if (AccessSet::is_read(c, r)) {
+                            stencil[UID(c, r)] = stencil_buffer[stage][c][r];
+                        }
+                    }
+                }
 
                 if (i_generation + stage < target_i_generation) {
-                    value = trans_func(stencil);
+                    T new_value = uniforms.apply(trans_func, stencil);
+
+                    bool is_last_stage = stage == pipeline_length - 1 ||
+                                         i_generation + stage + 1 == target_i_generation;
+                    index_t output_tile_c = output_grid_c - index_t(grid_c_offset);
+                    index_t output_tile_r = output_grid_r - index_t(grid_r_offset);
+                    bool is_tile_cell = output_tile_c >= 0 && output_tile_r >= 0 &&
+                                        output_tile_c < index_t(output_tile_width) &&
+                                        output_tile_r < index_t(output_tile_height) &&
+                                        output_grid_c < index_t(grid_width) &&
+                                        output_grid_r < index_t(grid_height);
+                    if (is_last_stage && is_tile_cell) {
+                        reduced = reduction.combine(
+                            reduced,
+                            reduction.map(stencil_buffer[stage][stencil_radius][stencil_radius],
+                                          new_value));
+                    }
+
+                    value = new_value;
                 } else {
                     value = stencil_buffer[stage][stencil_radius][stencil_radius];
                 }
@@ -194,10 +269,12 @@ class ExecutionKernel {
                 input_tile_r++;
             }
         }
+
+        return reduced;
     }
 
-  private:
     TransFunc trans_func;
+    UniformTableImpl uniforms;
     uindex_t i_generation;
     uindex_t target_i_generation;
     uindex_t grid_c_offset;
@@ -101,6 +101,62 @@ class Grid {
         }
     }
 
+    /**
+     * \brief Copy a strided region of the grid to a given buffer.
+     *
+     * The cell `(c, r)` of the buffer is set to the cell `(region_offset.c + c * stride.c,
+     * region_offset.r + r * stride.r)` of the grid. Only the tile parts that contain any of these
+     * cells are accessed, and for every one of them, a kernel is submitted that picks the requested
+     * cells on the device. Therefore, only the selected cells are transferred to the buffer.
+     *
+     * \param fpga_queue The queue to submit the copy kernels to.
+     * \param out_buffer The buffer to copy the cells to.
+     * \param region_offset The index of the first cell to copy.
+     * \param stride The distance between two copied cells in every direction.
+     * \throws std::invalid_argument The stride is zero in any direction.
+     * \throws std::out_of_range The buffer would contain cells outside of the grid.
+     */
+    void copy_to(cl::sycl::queue fpga_queue, cl::sycl::buffer<T, 2> &out_buffer, UID region_offset,
+                 UID stride) {
+        if (stride.c == 0 || stride.r == 0) {
+            throw std::invalid_argument("The stride must not be zero");
+        }
+        cl::sycl::range<2> out_range = out_buffer.get_range();
+        if (out_range[0] == 0 || out_range[1] == 0) {
+            return;
+        }
+        UID region_end(region_offset.c + (out_range[0] - 1) * stride.c + 1,
+                       region_offset.r + (out_range[1] - 1) * stride.r + 1);
+        if (region_end.c > grid_range[0] || region_end.r > grid_range[1]) {
+            throw std::out_of_range("The requested region exceeds the grid");
+        }
+
+        for (uindex_t tile_c = region_offset.c / tile_width;
+             tile_c <= (region_end.c - 1) / tile_width; tile_c++) {
+            for (uindex_t tile_r = region_offset.r / tile_height;
+                 tile_r <= (region_end.r - 1) / tile_height; tile_r++) {
+                for (auto part : Tile::all_parts) {
+                    cl::sycl::id<2> part_offset = Tile::get_part_offset(part);
+                    cl::sycl::range<2> part_range = Tile::get_part_range(part);
+                    UID part_begin(tile_c * tile_width + part_offset[0],
+                                   tile_r * tile_height + part_offset[1]);
+                    UID part_end(std::min<uindex_t>(part_begin.c + part_range[0], region_end.c),
+                                 std::min<uindex_t>(part_begin.r + part_range[1], region_end.r));
+                    UID first_cell(first_selected_index(part_begin.c, region_offset.c, stride.c),
+                                   first_selected_index(part_begin.r, region_offset.r, stride.r));
+                    if (first_cell.c >= part_end.c || first_cell.r >= part_end.r) {
+                        // None of the requested cells is in this part.
+                        continue;
+                    }
+
+                    submit_region_copy_kernel(fpga_queue, tiles[tile_c + 1][tile_r + 1][part],
+                                              out_buffer, part_begin, part_range[1], first_cell,
+                                              part_end, region_offset, stride);
+                }
+            }
+        }
+    }
+
     /**
      * \brief Create a new grid that can be used as an output target.
      *
@@ -154,6 +210,68 @@ class Grid {
         return tiles[tile_c][tile_r];
     }
 
+    /**
+     * \brief Let a tile of this grid contain the same cells as the tile of another grid.
+     *
+     * The tile's buffers are shared with the other grid, no cells are copied. This is safe since
+     * the tiles of a grid are not altered after they have been written by \ref
+     * Grid.submit_tile_output.
+     *
+     * \param source The grid to take the tile from. It must have the same range as this grid.
+     * \param tile_id The id of the tile.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref Grid.get_tile_range.
+     */
+    void take_tile(Grid &source, UID tile_id) { get_tile(tile_id) = source.get_tile(tile_id); }
+
+    /**
+     * \brief Submit the kernels that check whether a tile differs from the tile of another grid.
+     *
+     * The cells are compared bitwise. If any cell of the tile differs, the flag with the index
+     * `tile_id.c * get_tile_range().r + tile_id.r` in `changed_flags` is set to true. Otherwise, it
+     * is left as-is.
+     *
+     * \param fpga_queue The queue to submit the kernels to.
+     * \param other The grid to compare with. It must have the same range as this grid.
+     * \param tile_id The id of the tile to compare.
+     * \param changed_flags The buffer with one flag per tile.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref Grid.get_tile_range.
+     */
+    void submit_tile_comparison(cl::sycl::queue fpga_queue, Grid &other, UID tile_id,
+                                cl::sycl::buffer<bool, 1> changed_flags) {
+        Tile &tile = get_tile(tile_id);
+        Tile &other_tile = other.get_tile(tile_id);
+        uindex_t i_flag = tile_id.c * get_tile_range().r + tile_id.r;
+
+        for (auto part : Tile::all_parts) {
+            cl::sycl::buffer<T, 2> part_buffer = tile[part];
+            cl::sycl::buffer<T, 2> other_part_buffer = other_tile[part];
+            uindex_t n_cells = Tile::get_part_range(part).size();
+
+            fpga_queue.submit([&](cl::sycl::handler &cgh) {
+                auto part_ac = part_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
+                auto other_part_ac =
+                    other_part_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
+                auto flags_ac =
+                    changed_flags.template get_access<cl::sycl::access::mode::read_write>(cgh);
+
+                cgh.single_task<class TileComparisonKernelLambda>([=]() {
+                    bool changed = false;
+                    for (uindex_t i_cell = 0; i_cell < n_cells; i_cell++) {
+                        uindex_t i_burst = i_cell / burst_length;
+                        uindex_t i_burst_cell = i_cell % burst_length;
+                        changed |= !is_bitwise_equal(part_ac[i_burst][i_burst_cell],
+                                                     other_part_ac[i_burst][i_burst_cell]);
+                    }
+                    if (changed) {
+                        flags_ac[i_flag] = true;
+                    }
+                });
+            });
+        }
+    }
+
     /**
      * \brief Submit the input kernels required for one execution of the \ref ExecutionKernel.
      *
@@ -163,68 +281,23 @@ class Grid {
      * \tparam in_pipe The pipe to write the cells to.
      * \param fpga_queue The configured SYCL queue for submissions.
      * \param tile_id The id of the tile to read.
+     * \return The events of the submitted kernels, in the order of submission.
      * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
      * \ref Grid.get_tile_range.
      */
-    template <typename in_pipe> void submit_tile_input(cl::sycl::queue fpga_queue, UID tile_id) {
+    template <typename in_pipe>
+    std::vector<cl::sycl::event> submit_tile_input(cl::sycl::queue fpga_queue, UID tile_id) {
         if (tile_id.c > get_tile_range().c || tile_id.r > get_tile_range().r) {
             throw std::out_of_range("Tile index out of range");
         }
 
-        uindex_t tile_c = tile_id.c + 1;
-        uindex_t tile_r = tile_id.r + 1;
-
-        submit_input_kernel<in_pipe>(
-            fpga_queue,
-            std::array<cl::sycl::buffer<T, 2>, 5>{
-                tiles[tile_c - 1][tile_r - 1][Tile::Part::SOUTH_EAST_CORNER],
-                tiles[tile_c - 1][tile_r][Tile::Part::NORTH_EAST_CORNER],
-                tiles[tile_c - 1][tile_r][Tile::Part::EAST_BORDER],
-                tiles[tile_c - 1][tile_r][Tile::Part::SOUTH_EAST_CORNER],
-                tiles[tile_c - 1][tile_r + 1][Tile::Part::NORTH_EAST_CORNER],
-            },
-            halo_radius);
-
-        submit_input_kernel<in_pipe>(fpga_queue,
-                                     std::array<cl::sycl::buffer<T, 2>, 5>{
-                                         tiles[tile_c][tile_r - 1][Tile::Part::SOUTH_WEST_CORNER],
-                                         tiles[tile_c][tile_r][Tile::Part::NORTH_WEST_CORNER],
-                                         tiles[tile_c][tile_r][Tile::Part::WEST_BORDER],
-                                         tiles[tile_c][tile_r][Tile::Part::SOUTH_WEST_CORNER],
-                                         tiles[tile_c][tile_r + 1][Tile::Part::NORTH_WEST_CORNER],
-                                     },
-                                     halo_radius);
-
-        submit_input_kernel<in_pipe>(fpga_queue,
-                                     std::array<cl::sycl::buffer<T, 2>, 5>{
-                                         tiles[tile_c][tile_r - 1][Tile::Part::SOUTH_BORDER],
-                                         tiles[tile_c][tile_r][Tile::Part::NORTH_BORDER],
-                                         tiles[tile_c][tile_r][Tile::Part::CORE],
-                                         tiles[tile_c][tile_r][Tile::Part::SOUTH_BORDER],
-                                         tiles[tile_c][tile_r + 1][Tile::Part::NORTH_BORDER],
-                                     },
-                                     core_width);
-
-        submit_input_kernel<in_pipe>(fpga_queue,
-                                     std::array<cl::sycl::buffer<T, 2>, 5>{
-                                         tiles[tile_c][tile_r - 1][Tile::Part::SOUTH_EAST_CORNER],
-                                         tiles[tile_c][tile_r][Tile::Part::NORTH_EAST_CORNER],
-                                         tiles[tile_c][tile_r][Tile::Part::EAST_BORDER],
-                                         tiles[tile_c][tile_r][Tile::Part::SOUTH_EAST_CORNER],
-                                         tiles[tile_c][tile_r + 1][Tile::Part::NORTH_EAST_CORNER],
-                                     },
-                                     halo_radius);
-
-        submit_input_kernel<in_pipe>(
-            fpga_queue,
-            std::array<cl::sycl::buffer<T, 2>, 5>{
-                tiles[tile_c + 1][tile_r - 1][Tile::Part::SOUTH_WEST_CORNER],
-                tiles[tile_c + 1][tile_r][Tile::Part::NORTH_WEST_CORNER],
-                tiles[tile_c + 1][tile_r][Tile::Part::WEST_BORDER],
-                tiles[tile_c + 1][tile_r][Tile::Part::SOUTH_WEST_CORNER],
-                tiles[tile_c + 1][tile_r + 1][Tile::Part::NORTH_WEST_CORNER],
-            },
-            halo_radius);
+        std::vector<cl::sycl::event> events;
+        events.reserve(5);
+        for (InputColumn &column : get_input_columns(tile_id)) {
+            events.push_back(
+                submit_input_kernel<in_pipe>(fpga_queue, column.buffers, column.width));
+        }
+        return events;
     }
 
     /**
@@ -237,53 +310,186 @@ class Grid {
      * \tparam out_pipe The pipe to read the cells from.
      * \param fpga_queue The configured SYCL queue for submissions.
      * \param tile_id The id of the tile to write to.
+     * \return The events of the submitted kernels, in the order of submission.
      * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
      * \ref Grid.get_tile_range.
      */
-    template <typename out_pipe> void submit_tile_output(cl::sycl::queue fpga_queue, UID tile_id) {
+    template <typename out_pipe>
+    std::vector<cl::sycl::event> submit_tile_output(cl::sycl::queue fpga_queue, UID tile_id) {
         if (tile_id.c > get_tile_range().c || tile_id.r > get_tile_range().r) {
             throw std::out_of_range("Tile index out of range");
         }
 
-        uindex_t tile_c = tile_id.c + 1;
-        uindex_t tile_r = tile_id.r + 1;
+        std::vector<cl::sycl::event> events;
+        events.reserve(3);
+        for (OutputColumn &column : get_output_columns(tile_id)) {
+            events.push_back(
+                submit_output_kernel<out_pipe>(fpga_queue, column.buffers, column.width));
+        }
+        return events;
+    }
 
-        submit_output_kernel<out_pipe>(fpga_queue,
-                                       std::array<cl::sycl::buffer<T, 2>, 3>{
-                                           tiles[tile_c][tile_r][Tile::Part::NORTH_WEST_CORNER],
-                                           tiles[tile_c][tile_r][Tile::Part::WEST_BORDER],
-                                           tiles[tile_c][tile_r][Tile::Part::SOUTH_WEST_CORNER],
-                                       },
-                                       halo_radius);
-
-        submit_output_kernel<out_pipe>(fpga_queue,
-                                       std::array<cl::sycl::buffer<T, 2>, 3>{
-                                           tiles[tile_c][tile_r][Tile::Part::NORTH_BORDER],
-                                           tiles[tile_c][tile_r][Tile::Part::CORE],
-                                           tiles[tile_c][tile_r][Tile::Part::SOUTH_BORDER],
-                                       },
-                                       core_width);
-
-        submit_output_kernel<out_pipe>(fpga_queue,
-                                       std::array<cl::sycl::buffer<T, 2>, 3>{
-                                           tiles[tile_c][tile_r][Tile::Part::NORTH_EAST_CORNER],
-                                           tiles[tile_c][tile_r][Tile::Part::EAST_BORDER],
-                                           tiles[tile_c][tile_r][Tile::Part::SOUTH_EAST_CORNER],
-                                       },
-                                       halo_radius);
+    /**
+     * \brief Run the input kernels of a tile on the calling host thread.
+     *
+     * This is the host counterpart of \ref Grid.submit_tile_input: It runs the same five \ref
+     * IOKernel instances in the same order, but with host accessors. The `in_pipe` therefore has
+     * to be a host pipe like \ref BoundedHostPipe, and the execution kernel has to run
+     * concurrently on another thread.
+     *
+     * \tparam in_pipe The pipe to write the cells to.
+     * \param tile_id The id of the tile to read.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref Grid.get_tile_range.
+     */
+    template <typename in_pipe> void run_tile_input(UID tile_id) {
+        if (tile_id.c > get_tile_range().c || tile_id.r > get_tile_range().r) {
+            throw std::out_of_range("Tile index out of range");
+        }
+
+        using InputKernel =
+            IOKernel<T, halo_radius, core_height, burst_length, in_pipe, 2,
+                     cl::sycl::access::mode::read, cl::sycl::access::target::host_buffer>;
+
+        for (InputColumn &column : get_input_columns(tile_id)) {
+            std::array<typename InputKernel::Accessor, 5> accessor{
+                column.buffers[0].template get_access<cl::sycl::access::mode::read>(),
+                column.buffers[1].template get_access<cl::sycl::access::mode::read>(),
+                column.buffers[2].template get_access<cl::sycl::access::mode::read>(),
+                column.buffers[3].template get_access<cl::sycl::access::mode::read>(),
+                column.buffers[4].template get_access<cl::sycl::access::mode::read>(),
+            };
+            InputKernel(accessor, column.width).read();
+        }
+    }
+
+    /**
+     * \brief Run the output kernels of a tile on the calling host thread.
+     *
+     * This is the host counterpart of \ref Grid.submit_tile_output. See \ref Grid.run_tile_input
+     * for details.
+     *
+     * \tparam out_pipe The pipe to read the cells from.
+     * \param tile_id The id of the tile to write to.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref Grid.get_tile_range.
+     */
+    template <typename out_pipe> void run_tile_output(UID tile_id) {
+        if (tile_id.c > get_tile_range().c || tile_id.r > get_tile_range().r) {
+            throw std::out_of_range("Tile index out of range");
+        }
+
+        using OutputKernel =
+            IOKernel<T, halo_radius, core_height, burst_length, out_pipe, 1,
+                     cl::sycl::access::mode::discard_write, cl::sycl::access::target::host_buffer>;
+
+        for (OutputColumn &column : get_output_columns(tile_id)) {
+            std::array<typename OutputKernel::Accessor, 3> accessor{
+                column.buffers[0].template get_access<cl::sycl::access::mode::discard_write>(),
+                column.buffers[1].template get_access<cl::sycl::access::mode::discard_write>(),
+                column.buffers[2].template get_access<cl::sycl::access::mode::discard_write>(),
+            };
+            OutputKernel(accessor, column.width).write();
+        }
     }
 
   private:
     static constexpr uindex_t core_height = tile_height - 2 * halo_radius;
     static constexpr uindex_t core_width = tile_width - 2 * halo_radius;
 
+    /*
+     * A column of tile parts that is read or written by one IO kernel, with the width of the parts.
+     */
+    struct InputColumn {
+        std::array<cl::sycl::buffer<T, 2>, 5> buffers;
+        uindex_t width;
+    };
+
+    struct OutputColumn {
+        std::array<cl::sycl::buffer<T, 2>, 3> buffers;
+        uindex_t width;
+    };
+
+    std::array<InputColumn, 5> get_input_columns(UID tile_id) {
+        uindex_t tile_c = tile_id.c + 1;
+        uindex_t tile_r = tile_id.r + 1;
+        return std::array<InputColumn, 5>{
+            InputColumn{{
+                            tiles[tile_c - 1][tile_r - 1][Tile::Part::SOUTH_EAST_CORNER],
+                            tiles[tile_c - 1][tile_r][Tile::Part::NORTH_EAST_CORNER],
+                            tiles[tile_c - 1][tile_r][Tile::Part::EAST_BORDER],
+                            tiles[tile_c - 1][tile_r][Tile::Part::SOUTH_EAST_CORNER],
+                            tiles[tile_c - 1][tile_r + 1][Tile::Part::NORTH_EAST_CORNER],
+                        },
+                        halo_radius},
+            InputColumn{{
+                            tiles[tile_c][tile_r - 1][Tile::Part::SOUTH_WEST_CORNER],
+                            tiles[tile_c][tile_r][Tile::Part::NORTH_WEST_CORNER],
+                            tiles[tile_c][tile_r][Tile::Part::WEST_BORDER],
+                            tiles[tile_c][tile_r][Tile::Part::SOUTH_WEST_CORNER],
+                            tiles[tile_c][tile_r + 1][Tile::Part::NORTH_WEST_CORNER],
+                        },
+                        halo_radius},
+            InputColumn{{
+                            tiles[tile_c][tile_r - 1][Tile::Part::SOUTH_BORDER],
+                            tiles[tile_c][tile_r][Tile::Part::NORTH_BORDER],
+                            tiles[tile_c][tile_r][Tile::Part::CORE],
+                            tiles[tile_c][tile_r][Tile::Part::SOUTH_BORDER],
+                            tiles[tile_c][tile_r + 1][Tile::Part::NORTH_BORDER],
+                        },
+                        core_width},
+            InputColumn{{
+                            tiles[tile_c][tile_r - 1][Tile::Part::SOUTH_EAST_CORNER],
+                            tiles[tile_c][tile_r][Tile::Part::NORTH_EAST_CORNER],
+                            tiles[tile_c][tile_r][Tile::Part::EAST_BORDER],
+                            tiles[tile_c][tile_r][Tile::Part::SOUTH_EAST_CORNER],
+                            tiles[tile_c][tile_r + 1][Tile::Part::NORTH_EAST_CORNER],
+                        },
+                        halo_radius},
+            InputColumn{{
+                            tiles[tile_c + 1][tile_r - 1][Tile::Part::SOUTH_WEST_CORNER],
+                            tiles[tile_c + 1][tile_r][Tile::Part::NORTH_WEST_CORNER],
+                            tiles[tile_c + 1][tile_r][Tile::Part::WEST_BORDER],
+                            tiles[tile_c + 1][tile_r][Tile::Part::SOUTH_WEST_CORNER],
+                            tiles[tile_c + 1][tile_r + 1][Tile::Part::NORTH_WEST_CORNER],
+                        },
+                        halo_radius},
+        };
+    }
+
+    std::array<OutputColumn, 3> get_output_columns(UID tile_id) {
+        uindex_t tile_c = tile_id.c + 1;
+        uindex_t tile_r = tile_id.r + 1;
+        return std::array<OutputColumn, 3>{
+            OutputColumn{{
+                             tiles[tile_c][tile_r][Tile::Part::NORTH_WEST_CORNER],
+                             tiles[tile_c][tile_r][Tile::Part::WEST_BORDER],
+                             tiles[tile_c][tile_r][Tile::Part::SOUTH_WEST_CORNER],
+                         },
+                         halo_radius},
+            OutputColumn{{
+                             tiles[tile_c][tile_r][Tile::Part::NORTH_BORDER],
+                             tiles[tile_c][tile_r][Tile::Part::CORE],
+                             tiles[tile_c][tile_r][Tile::Part::SOUTH_BORDER],
+                         },
+                         core_width},
+            OutputColumn{{
+                             tiles[tile_c][tile_r][Tile::Part::NORTH_EAST_CORNER],
+                             tiles[tile_c][tile_r][Tile::Part::EAST_BORDER],
+                             tiles[tile_c][tile_r][Tile::Part::SOUTH_EAST_CORNER],
+                         },
+                         halo_radius},
+        };
+    }
+
     template <typename pipe>
-    void submit_input_kernel(cl::sycl::queue fpga_queue,
-                             std::array<cl::sycl::buffer<T, 2>, 5> buffer, uindex_t buffer_width) {
+    cl::sycl::event submit_input_kernel(cl::sycl::queue fpga_queue,
+                                        std::array<cl::sycl::buffer<T, 2>, 5> buffer,
+                                        uindex_t buffer_width) {
         using InputKernel = IOKernel<T, halo_radius, core_height, burst_length, pipe, 2,
                                      cl::sycl::access::mode::read>;
 
-        fpga_queue.submit([&](cl::sycl::handler &cgh) {
+        return fpga_queue.submit([&](cl::sycl::handler &cgh) {
             std::array<typename InputKernel::Accessor, 5> accessor{
                 buffer[0].template get_access<cl::sycl::access::mode::read>(cgh),
                 buffer[1].template get_access<cl::sycl::access::mode::read>(cgh),
@@ -298,12 +504,13 @@ class Grid {
     }
 
     template <typename pipe>
-    void submit_output_kernel(cl::sycl::queue fpga_queue,
-                              std::array<cl::sycl::buffer<T, 2>, 3> buffer, uindex_t buffer_width) {
+    cl::sycl::event submit_output_kernel(cl::sycl::queue fpga_queue,
+                                         std::array<cl::sycl::buffer<T, 2>, 3> buffer,
+                                         uindex_t buffer_width) {
         using OutputKernel = IOKernel<T, halo_radius, core_height, burst_length, pipe, 1,
                                       cl::sycl::access::mode::discard_write>;
 
-        fpga_queue.submit([&](cl::sycl::handler &cgh) {
+        return fpga_queue.submit([&](cl::sycl::handler &cgh) {
             std::array<typename OutputKernel::Accessor, 3> accessor{
                 buffer[0].template get_access<cl::sycl::access::mode::discard_write>(cgh),
                 buffer[1].template get_access<cl::sycl::access::mode::discard_write>(cgh),
@@ -315,6 +522,34 @@ class Grid {
         });
     }
 
+    static uindex_t first_selected_index(uindex_t begin, uindex_t region_offset, uindex_t stride) {
+        if (begin <= region_offset) {
+            return region_offset;
+        } else {
+            return region_offset + ((begin - region_offset + stride - 1) / stride) * stride;
+        }
+    }
+
+    void submit_region_copy_kernel(cl::sycl::queue fpga_queue, cl::sycl::buffer<T, 2> part_buffer,
+                                   cl::sycl::buffer<T, 2> &out_buffer, UID part_begin,
+                                   uindex_t part_height, UID first_cell, UID end_cell,
+                                   UID region_offset, UID stride) {
+        fpga_queue.submit([&](cl::sycl::handler &cgh) {
+            auto part_ac = part_buffer.template get_access<cl::sycl::access::mode::read>(cgh);
+            auto out_ac = out_buffer.template get_access<cl::sycl::access::mode::write>(cgh);
+
+            cgh.single_task<class RegionCopyKernelLambda>([=]() {
+                for (uindex_t c = first_cell.c; c < end_cell.c; c += stride.c) {
+                    for (uindex_t r = first_cell.r; r < end_cell.r; r += stride.r) {
+                        uindex_t i_cell = (c - part_begin.c) * part_height + (r - part_begin.r);
+                        out_ac[(c - region_offset.c) / stride.c][(r - region_offset.r) / stride.r] =
+                            part_ac[i_cell / burst_length][i_cell % burst_length];
+                    }
+                }
+            });
+        });
+    }
+
     void copy_from(cl::sycl::buffer<T, 2> in_buffer) {
         if (in_buffer.get_range() != grid_range) {
             throw std::range_error("The target buffer has not the same size as the grid");
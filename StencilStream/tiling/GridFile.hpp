@@ -0,0 +1,390 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "Grid.hpp"
+#include "OutOfCoreGrid.hpp"
+#include <cstdint>
+#include <fstream>
+#include <sys/stat.h>
+
+namespace stencil {
+namespace tiling {
+
+/**
+ * \brief The header of a \ref GridFile.
+ */
+struct GridFileHeader {
+    /**
+     * \brief The magic string, always "STSTGRID".
+     */
+    char magic[8];
+
+    /**
+     * \brief The version of the file format.
+     */
+    uint32_t version;
+
+    /**
+     * \brief The size of a cell in bytes.
+     */
+    uint32_t cell_size;
+
+    /**
+     * \brief The number of columns of a tile.
+     */
+    uint64_t tile_width;
+
+    /**
+     * \brief The number of rows of a tile.
+     */
+    uint64_t tile_height;
+
+    /**
+     * \brief The radius of the tile halo.
+     */
+    uint64_t halo_radius;
+
+    /**
+     * \brief The number of cells in a burst.
+     */
+    uint64_t burst_length;
+
+    /**
+     * \brief The number of columns of the grid.
+     */
+    uint64_t grid_width;
+
+    /**
+     * \brief The number of rows of the grid.
+     */
+    uint64_t grid_height;
+
+    /**
+     * \brief The generation index of the grid. Zero if the grid has not been written as a
+     * checkpoint.
+     */
+    uint64_t i_generation;
+
+    /**
+     * \brief A hash of the configuration of the executor that wrote the grid. Zero if the grid has
+     * not been written as a checkpoint.
+     */
+    uint64_t config_hash;
+};
+
+/**
+ * \brief Reader and writer for grid files with a tile-aligned layout.
+ *
+ * Converting between monolithic buffers and the tiled grid layout requires to partition every
+ * tile, which is slow for big grids. Grid files therefore store the tiles exactly in the layout of
+ * the \ref OutOfCoreGrid: A grid file starts with a \ref GridFile.Header, which is padded to \ref
+ * GridFile.header_size bytes, followed by the tiles in column-major order. Every tile consists of
+ * its nine parts in the order of \ref Tile.all_parts, and every part is stored with the same \ref
+ * burstalignment as a part buffer of a \ref Tile. The cells are stored as their raw bytes, with the
+ * native byte order of the host.
+ *
+ * Since the header is padded to 4096 bytes, the tile data can be memory-mapped directly. \ref
+ * GridFile.map_grid uses the mapped file as the memory of an \ref OutOfCoreGrid without copying it
+ * and \ref GridFile.read_grid copies the parts directly into the part buffers of a \ref Grid. In
+ * both cases, the cells are never repartitioned.
+ *
+ * A grid file can only be read with the same cell size, tile size, halo radius and burst length it
+ * was written with.
+ *
+ * \tparam T Cell value type. It has to be trivially copyable.
+ * \tparam tile_width The number of columns of a tile.
+ * \tparam tile_height The number of rows of a tile.
+ * \tparam halo_radius The radius (aka width and height) of the tile halo.
+ * \tparam burst_length The number of elements that can be read or written in a burst.
+ */
+template <typename T, uindex_t tile_width, uindex_t tile_height, uindex_t halo_radius,
+          uindex_t burst_length>
+class GridFile {
+    static_assert(std::is_trivially_copyable<T>::value);
+
+  public:
+    /**
+     * \brief The tiled grid type that stores its tiles in device memory.
+     */
+    using GridImpl = Grid<T, tile_width, tile_height, halo_radius, burst_length>;
+
+    /**
+     * \brief The tiled grid type that stores its tiles in host memory.
+     */
+    using OutOfCoreGridImpl = OutOfCoreGrid<T, tile_width, tile_height, halo_radius, burst_length>;
+
+  private:
+    using TileImpl = Tile<T, tile_width, tile_height, halo_radius, burst_length>;
+
+  public:
+    /**
+     * \brief The current version of the file format.
+     */
+    static constexpr uint32_t version = 1;
+
+    /**
+     * \brief The offset of the tile data in the file, in bytes.
+     */
+    static constexpr uint64_t header_size = 4096;
+
+    /**
+     * \brief The header of a grid file.
+     */
+    using Header = GridFileHeader;
+    static_assert(sizeof(Header) <= header_size);
+
+    /**
+     * \brief Create the header for a grid with the given range.
+     */
+    static Header make_header(UID grid_range, uint64_t i_generation = 0, uint64_t config_hash = 0) {
+        Header header;
+        std::memcpy(header.magic, "STSTGRID", sizeof(header.magic));
+        header.version = version;
+        header.cell_size = sizeof(T);
+        header.tile_width = tile_width;
+        header.tile_height = tile_height;
+        header.halo_radius = halo_radius;
+        header.burst_length = burst_length;
+        header.grid_width = grid_range.c;
+        header.grid_height = grid_range.r;
+        header.i_generation = i_generation;
+        header.config_hash = config_hash;
+        return header;
+    }
+
+    /**
+     * \brief Read and validate the header of a grid file.
+     *
+     * \throws std::runtime_error Thrown if the file could not be read, is not a grid file or has
+     * been written with a different configuration.
+     */
+    static Header read_header(std::string const &path) {
+        std::ifstream file(path, std::ios::binary);
+        Header header;
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(Header))) {
+            throw std::runtime_error("Could not read the header of the grid file " + path);
+        }
+        validate_header(header, path);
+        return header;
+    }
+
+    /**
+     * \brief Write a grid that stores its tiles in device memory to a file.
+     *
+     * \param i_generation The generation index to store in the header.
+     * \param config_hash The configuration hash to store in the header.
+     * \throws std::runtime_error Thrown if the file could not be written.
+     */
+    static void write(std::string const &path, GridImpl &grid, uint64_t i_generation = 0,
+                      uint64_t config_hash = 0) {
+        UID tile_range = grid.get_tile_range();
+        std::ofstream file =
+            open_for_writing(path, make_header(grid.get_grid_range(), i_generation, config_hash));
+
+        for (uindex_t tile_c = 0; tile_c < tile_range.c; tile_c++) {
+            for (uindex_t tile_r = 0; tile_r < tile_range.r; tile_r++) {
+                auto &tile = grid.get_tile(UID(tile_c, tile_r));
+                for (auto part : TileImpl::all_parts) {
+                    auto part_ac = tile[part].template get_access<cl::sycl::access::mode::read>();
+                    file.write(reinterpret_cast<char const *>(part_ac.get_pointer()),
+                               OutOfCoreGridImpl::get_n_part_cells(part) * sizeof(T));
+                }
+            }
+        }
+
+        close_after_writing(file, path);
+    }
+
+    /**
+     * \brief Write a grid that stores its tiles in host memory to a file.
+     *
+     * Pending outputs of the grid are written back to host memory first.
+     *
+     * \param i_generation The generation index to store in the header.
+     * \param config_hash The configuration hash to store in the header.
+     * \throws std::runtime_error Thrown if the file could not be written.
+     */
+    static void write(std::string const &path, OutOfCoreGridImpl &grid, uint64_t i_generation = 0,
+                      uint64_t config_hash = 0) {
+        UID tile_range = grid.get_tile_range();
+        std::ofstream file =
+            open_for_writing(path, make_header(grid.get_grid_range(), i_generation, config_hash));
+
+        grid.flush();
+        if (tile_range.c * tile_range.r != 0) {
+            file.write(reinterpret_cast<char const *>(grid.get_tile_cells(UID(0, 0))),
+                       tile_range.c * tile_range.r * OutOfCoreGridImpl::n_tile_cells * sizeof(T));
+        }
+
+        close_after_writing(file, path);
+    }
+
+    /**
+     * \brief Partition the cells of a monolithic buffer and write them to a file.
+     *
+     * This can be used to write buffers filled by \ref AbstractExecutor.copy_output. Writing the
+     * internal grid of an executor, for example retrieved with \ref StencilExecutor.get_grid, is
+     * faster since the cells are already partitioned.
+     *
+     * \param i_generation The generation index to store in the header.
+     * \param config_hash The configuration hash to store in the header.
+     * \throws std::runtime_error Thrown if the file could not be written.
+     */
+    static void write(std::string const &path, cl::sycl::buffer<T, 2> buffer,
+                      uint64_t i_generation = 0, uint64_t config_hash = 0) {
+        OutOfCoreGridImpl grid(buffer);
+        write(path, grid, i_generation, config_hash);
+    }
+
+    /**
+     * \brief Read a grid file into a grid that stores its tiles in device memory.
+     *
+     * The file is memory-mapped and its parts are copied directly into the part buffers of the
+     * tiles.
+     *
+     * \throws std::runtime_error Thrown if the file could not be read, is not a grid file or has
+     * been written with a different configuration.
+     */
+    static GridImpl read_grid(std::string const &path) {
+        Header header;
+        std::shared_ptr<T> cells = map_file(path, false, header);
+        GridImpl grid(header.grid_width, header.grid_height);
+        UID tile_range = grid.get_tile_range();
+
+        T const *tile_cells = cells.get();
+        for (uindex_t tile_c = 0; tile_c < tile_range.c; tile_c++) {
+            for (uindex_t tile_r = 0; tile_r < tile_range.r; tile_r++) {
+                auto &tile = grid.get_tile(UID(tile_c, tile_r));
+                for (auto part : TileImpl::all_parts) {
+                    auto part_ac =
+                        tile[part].template get_access<cl::sycl::access::mode::discard_write>();
+                    std::memcpy(part_ac.get_pointer(),
+                                tile_cells + OutOfCoreGridImpl::get_part_cell_offset(part),
+                                OutOfCoreGridImpl::get_n_part_cells(part) * sizeof(T));
+                }
+                tile_cells += OutOfCoreGridImpl::n_tile_cells;
+            }
+        }
+
+        return grid;
+    }
+
+    /**
+     * \brief Map a grid file into memory and use it as the memory of a grid that stores its tiles
+     * in host memory.
+     *
+     * The file is mapped privately, which means that it is never altered, and it is only read
+     * when the tiles are accessed.
+     *
+     * \param path The path to the grid file.
+     * \param n_resident_tiles The number of tiles whose buffers are kept alive at the same time.
+     * \throws std::runtime_error Thrown if the file could not be read, is not a grid file or has
+     * been written with a different configuration.
+     */
+    static OutOfCoreGridImpl
+    map_grid(std::string const &path,
+             uindex_t n_resident_tiles = OutOfCoreGridImpl::default_n_resident_tiles) {
+        Header header;
+        std::shared_ptr<T> cells = map_file(path, true, header);
+        return OutOfCoreGridImpl(header.grid_width, header.grid_height, cells, n_resident_tiles);
+    }
+
+  private:
+    static uint64_t get_n_data_bytes(Header const &header) {
+        uint64_t n_tile_columns = header.grid_width / tile_width;
+        if (header.grid_width % tile_width != 0) {
+            n_tile_columns++;
+        }
+        uint64_t n_tile_rows = header.grid_height / tile_height;
+        if (header.grid_height % tile_height != 0) {
+            n_tile_rows++;
+        }
+        return n_tile_columns * n_tile_rows * OutOfCoreGridImpl::n_tile_cells * sizeof(T);
+    }
+
+    static void validate_header(Header const &header, std::string const &path) {
+        if (std::memcmp(header.magic, "STSTGRID", sizeof(header.magic)) != 0) {
+            throw std::runtime_error(path + " is not a grid file");
+        }
+        if (header.version != version) {
+            throw std::runtime_error(path + " has an unsupported version");
+        }
+        if (header.cell_size != sizeof(T) || header.tile_width != tile_width ||
+            header.tile_height != tile_height || header.halo_radius != halo_radius ||
+            header.burst_length != burst_length) {
+            throw std::runtime_error(path + " has been written with a different configuration");
+        }
+    }
+
+    static std::ofstream open_for_writing(std::string const &path, Header const &header) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        char padded_header[header_size] = {0};
+        std::memcpy(padded_header, &header, sizeof(Header));
+        file.write(padded_header, header_size);
+        if (!file) {
+            throw std::runtime_error("Could not write the grid file " + path);
+        }
+        return file;
+    }
+
+    static void close_after_writing(std::ofstream &file, std::string const &path) {
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Could not write the grid file " + path);
+        }
+    }
+
+    static std::shared_ptr<T> map_file(std::string const &path, bool writable, Header &header) {
+        header = read_header(path);
+        uint64_t n_data_bytes = get_n_data_bytes(header);
+
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::runtime_error("Could not open the grid file " + path + ": " +
+                                     std::strerror(errno));
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0 ||
+            uint64_t(file_stat.st_size) < header_size + n_data_bytes) {
+            close(fd);
+            throw std::runtime_error("The grid file " + path + " is truncated");
+        }
+        if (n_data_bytes == 0) {
+            close(fd);
+            return std::shared_ptr<T>();
+        }
+
+        int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *mapping = mmap(nullptr, header_size + n_data_bytes, protection, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Could not map the grid file " + path + ": " +
+                                     std::strerror(errno));
+        }
+
+        uint64_t n_mapped_bytes = header_size + n_data_bytes;
+        T *cells = reinterpret_cast<T *>(static_cast<char *>(mapping) + header_size);
+        return std::shared_ptr<T>(
+            cells, [mapping, n_mapped_bytes](T *) { munmap(mapping, n_mapped_bytes); });
+    }
+};
+
+} // namespace tiling
+} // namespace stencil
@@ -0,0 +1,649 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "../GenericID.hpp"
+#include "IOKernel.hpp"
+#include "Tile.hpp"
+#include <CL/sycl/accessor.hpp>
+#include <CL/sycl/buffer.hpp>
+#include <CL/sycl/queue.hpp>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <sys/mman.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+namespace stencil {
+namespace tiling {
+
+/**
+ * \brief A grid that keeps its cells in host memory instead of device memory.
+ *
+ * This class is a drop-in replacement for \ref Grid that can be used with the \ref StencilExecutor
+ * to process grids that don't fit into the memory of the device. It stores all tiles in a single
+ * host allocation, either in anonymous memory or in a memory-mapped swap file. Within this
+ * allocation, the tiles are stored in column-major order and every tile consists of its nine
+ * parts, in the order of \ref Tile.all_parts and with the same \ref burstalignment as the buffers
+ * of a \ref Tile.
+ *
+ * Device buffers only exist for the parts of the tiles that are currently processed: Every call to
+ * \ref OutOfCoreGrid.submit_tile_input and \ref OutOfCoreGrid.submit_tile_output wraps the
+ * required parts of the 3x3 tile neighborhood in buffers that use the host memory, and these
+ * buffers are kept alive for the next `n_resident_tiles - 1` submissions. The device memory usage
+ * is therefore bounded by the window size and not by the grid range.
+ *
+ * When buffers leave the window, they are destroyed on the submitting thread, which waits for their
+ * kernels and writes their outputs back to host memory. There is no background write-back: With
+ * the default of two resident tiles, a submission blocks until the tile two submissions earlier
+ * has completed, so the grid only provides a lookahead of one tile. Larger windows increase the
+ * lookahead at the cost of device memory.
+ *
+ * \tparam T Cell value type. It has to be trivially copyable.
+ * \tparam tile_width The number of columns of a tile.
+ * \tparam tile_height The number of rows of a tile.
+ * \tparam halo_radius The radius (aka width and height) of the tile halo.
+ * \tparam burst_length The number of elements that can be read or written in a burst.
+ */
+template <typename T, uindex_t tile_width, uindex_t tile_height, uindex_t halo_radius,
+          uindex_t burst_length>
+class OutOfCoreGrid {
+    static_assert(std::is_trivially_copyable<T>::value);
+
+  private:
+    using TileImpl = Tile<T, tile_width, tile_height, halo_radius, burst_length>;
+
+  public:
+    /**
+     * \brief The parts of a tile, as defined by \ref Tile.
+     */
+    using Part = typename TileImpl::Part;
+
+    /**
+     * \brief The default number of tiles whose buffers are kept alive at the same time.
+     *
+     * This gives a lookahead of one tile.
+     */
+    static constexpr uindex_t default_n_resident_tiles = 2;
+
+    /**
+     * \brief Create a grid with undefined contents.
+     *
+     * \param width The number of columns of the grid.
+     * \param height The number of rows of the grid.
+     * \param swap_directory If set, the cells are stored in a memory-mapped file in this directory
+     * instead of anonymous memory. The file is unlinked right after its creation and is therefore
+     * removed when the grid is destroyed.
+     * \param n_resident_tiles The number of tiles whose buffers are kept alive at the same time.
+     * Must be at least 1.
+     * \throws std::runtime_error Thrown if the memory could not be allocated or mapped.
+     */
+    OutOfCoreGrid(uindex_t width, uindex_t height,
+                  std::optional<std::string> swap_directory = std::nullopt,
+                  uindex_t n_resident_tiles = default_n_resident_tiles)
+        : state(std::make_shared<State>()), grid_range(width, height),
+          tile_range(div_ceil(width, tile_width), div_ceil(height, tile_height)),
+          swap_directory(swap_directory),
+          n_resident_tiles(std::max<uindex_t>(1, n_resident_tiles)) {
+        state->cells = allocate_cells(tile_range.c * tile_range.r * n_tile_cells, swap_directory);
+    }
+
+    /**
+     * \brief Create a grid that uses existing host memory.
+     *
+     * The memory has to contain the tiles in the layout described above, which means that it has
+     * to contain at least `tile_range.c * tile_range.r * n_tile_cells` cells. Grids created with
+     * \ref OutOfCoreGrid.make_output_grid use anonymous memory.
+     *
+     * \param width The number of columns of the grid.
+     * \param height The number of rows of the grid.
+     * \param cells The memory that contains the tiles.
+     * \param n_resident_tiles The number of tiles whose buffers are kept alive at the same time.
+     * Must be at least 1.
+     */
+    OutOfCoreGrid(uindex_t width, uindex_t height, std::shared_ptr<T> cells,
+                  uindex_t n_resident_tiles = default_n_resident_tiles)
+        : state(std::make_shared<State>()), grid_range(width, height),
+          tile_range(div_ceil(width, tile_width), div_ceil(height, tile_height)),
+          swap_directory(std::nullopt),
+          n_resident_tiles(std::max<uindex_t>(1, n_resident_tiles)) {
+        state->cells = cells;
+    }
+
+    /**
+     * \brief Create a grid in anonymous memory that contains the cells of a buffer.
+     *
+     * \param in_buffer The buffer to copy the cells from.
+     */
+    OutOfCoreGrid(cl::sycl::buffer<T, 2> in_buffer)
+        : OutOfCoreGrid(in_buffer.get_range()[0], in_buffer.get_range()[1]) {
+        copy_from(in_buffer);
+    }
+
+    /**
+     * \brief The number of cells of a part in host memory, including the burst padding.
+     */
+    static uindex_t get_n_part_cells(Part part) {
+        cl::sycl::range<2> part_range = TileImpl::get_part_range(part);
+        return burst_partitioned_range(part_range[0], part_range[1], burst_length)[0] *
+               burst_length;
+    }
+
+    /**
+     * \brief The offset of a part relative to the start of its tile in host memory, in cells.
+     */
+    static uindex_t get_part_cell_offset(Part part) {
+        uindex_t offset = 0;
+        for (Part other_part : TileImpl::all_parts) {
+            if (other_part == part) {
+                break;
+            }
+            offset += get_n_part_cells(other_part);
+        }
+        return offset;
+    }
+
+    /**
+     * \brief The number of cells of a tile in host memory, including the burst padding.
+     */
+    static inline const uindex_t n_tile_cells = get_part_cell_offset(Part::CORE) +
+                                                get_n_part_cells(Part::CORE);
+
+    /**
+     * \brief Copy the contents of the grid to a given buffer.
+     *
+     * All pending outputs are written back to host memory first.
+     *
+     * \param out_buffer The buffer to copy the cells to.
+     * \throws std::range_error The buffer's size is not the same as the grid's size.
+     */
+    void copy_to(cl::sycl::buffer<T, 2> &out_buffer) {
+        if (out_buffer.get_range() != grid_range) {
+            throw std::range_error("The target buffer has not the same size as the grid");
+        }
+        flush();
+
+        auto ac = out_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+        for_each_cell([&](uindex_t c, uindex_t r, T &cell) { ac[c][r] = cell; });
+    }
+
+    /**
+     * \brief Copy a strided region of the grid to a given buffer.
+     *
+     * The cell `(c, r)` of the buffer is set to the cell `(region_offset.c + c * stride.c,
+     * region_offset.r + r * stride.r)` of the grid. All pending outputs are written back to host
+     * memory first. Since the cells are already in host memory, they are picked on the host and
+     * only the selected cells are touched.
+     *
+     * \param fpga_queue Unused, only present for interface compatibility with \ref Grid.
+     * \param out_buffer The buffer to copy the cells to.
+     * \param region_offset The index of the first cell to copy.
+     * \param stride The distance between two copied cells in every direction.
+     * \throws std::invalid_argument The stride is zero in any direction.
+     * \throws std::out_of_range The buffer would contain cells outside of the grid.
+     */
+    void copy_to(cl::sycl::queue fpga_queue, cl::sycl::buffer<T, 2> &out_buffer, UID region_offset,
+                 UID stride) {
+        if (stride.c == 0 || stride.r == 0) {
+            throw std::invalid_argument("The stride must not be zero");
+        }
+        cl::sycl::range<2> out_range = out_buffer.get_range();
+        if (out_range[0] == 0 || out_range[1] == 0) {
+            return;
+        }
+        if (region_offset.c + (out_range[0] - 1) * stride.c >= grid_range[0] ||
+            region_offset.r + (out_range[1] - 1) * stride.r >= grid_range[1]) {
+            throw std::out_of_range("The requested region exceeds the grid");
+        }
+        flush();
+
+        auto ac = out_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+        for (uindex_t c = 0; c < out_range[0]; c++) {
+            for (uindex_t r = 0; r < out_range[1]; r++) {
+                ac[c][r] = get_cell(
+                    UID(region_offset.c + c * stride.c, region_offset.r + r * stride.r));
+            }
+        }
+    }
+
+    /**
+     * \brief Create a new grid that can be used as an output target.
+     *
+     * The new grid has the same range, the same kind of memory and the same window size as this
+     * grid.
+     *
+     * \return The new grid.
+     */
+    OutOfCoreGrid make_output_grid() const {
+        return OutOfCoreGrid(grid_range[0], grid_range[1], swap_directory, n_resident_tiles);
+    }
+
+    /**
+     * \brief Return the range of tiles of the grid.
+     */
+    UID get_tile_range() const { return tile_range; }
+
+    /**
+     * \brief Return the range of the grid in cells.
+     */
+    UID get_grid_range() const { return grid_range; }
+
+    /**
+     * \brief Wait for all submitted kernels that use the grid and write their outputs back to host
+     * memory.
+     *
+     * Like the tile submission methods, this method may be called from another thread, for example
+     * to write a grid to a file while kernels are submitted.
+     */
+    void flush() {
+        std::lock_guard<std::recursive_mutex> lock(state->mutex);
+        state->resident_buffers.clear();
+        state->has_pending_outputs = false;
+    }
+
+    /**
+     * \brief Write the pending outputs of the grid back to host memory.
+     *
+     * Unlike \ref OutOfCoreGrid.flush, this does nothing if no outputs have been submitted since
+     * the last write-back. Therefore, it does not wait for the kernels of a grid that is only read,
+     * like the input grid of a pass.
+     */
+    void write_back_outputs() {
+        std::lock_guard<std::recursive_mutex> lock(state->mutex);
+        if (state->has_pending_outputs) {
+            flush();
+        }
+    }
+
+    /**
+     * \brief Let a tile of this grid contain the same cells as the tile of another grid.
+     *
+     * Pending outputs of the other grid are written back first and the cells of the tile are
+     * copied in host memory. Kernels that only read the other grid are not waited for, so that
+     * skipping a tile does not block the submission of the following tiles of a pass.
+     *
+     * \param source The grid to take the tile from. It must have the same range as this grid.
+     * \param tile_id The id of the tile.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref OutOfCoreGrid.get_tile_range.
+     */
+    void take_tile(OutOfCoreGrid &source, UID tile_id) {
+        source.write_back_outputs();
+        std::memcpy(get_tile_cells(tile_id), source.get_tile_cells(tile_id),
+                    n_tile_cells * sizeof(T));
+    }
+
+    /**
+     * \brief Check whether a tile differs from the tile of another grid.
+     *
+     * This has the same effect as \ref Grid.submit_tile_comparison, but since the cells are
+     * stored in host memory, the pending outputs of both grids are written back and the cells are
+     * compared on the host. Only the first comparison after a pass waits for its outputs, the
+     * following ones find no pending outputs.
+     *
+     * \param fpga_queue Unused, only present for interface compatibility with \ref Grid.
+     * \param other The grid to compare with. It must have the same range as this grid.
+     * \param tile_id The id of the tile to compare.
+     * \param changed_flags The buffer with one flag per tile.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref OutOfCoreGrid.get_tile_range.
+     */
+    void submit_tile_comparison(cl::sycl::queue fpga_queue, OutOfCoreGrid &other, UID tile_id,
+                                cl::sycl::buffer<bool, 1> changed_flags) {
+        write_back_outputs();
+        other.write_back_outputs();
+        T const *tile_cells = get_tile_cells(tile_id);
+        T const *other_tile_cells = other.get_tile_cells(tile_id);
+
+        bool changed = false;
+        for (Part part : TileImpl::all_parts) {
+            T const *part_cells = tile_cells + get_part_cell_offset(part);
+            T const *other_part_cells = other_tile_cells + get_part_cell_offset(part);
+            uindex_t n_cells = TileImpl::get_part_range(part).size();
+            for (uindex_t i_cell = 0; i_cell < n_cells; i_cell++) {
+                changed |= !is_bitwise_equal(part_cells[i_cell], other_part_cells[i_cell]);
+            }
+        }
+
+        if (changed) {
+            auto flags_ac = changed_flags.template get_access<cl::sycl::access::mode::read_write>();
+            flags_ac[tile_id.c * tile_range.r + tile_id.r] = true;
+        }
+    }
+
+    /**
+     * \brief Get a pointer to the host memory of a tile.
+     *
+     * The tile's parts are stored in the order of \ref Tile.all_parts. Pending outputs are not
+     * written back, use \ref OutOfCoreGrid.flush first if kernels have been submitted.
+     *
+     * \param tile_id The id of the tile.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref OutOfCoreGrid.get_tile_range.
+     */
+    T *get_tile_cells(UID tile_id) {
+        if (tile_id.c >= tile_range.c || tile_id.r >= tile_range.r) {
+            throw std::out_of_range("Tile index out of range");
+        }
+        return state->cells.get() + (tile_id.c * tile_range.r + tile_id.r) * n_tile_cells;
+    }
+
+    /**
+     * \brief Submit the input kernels required for one execution of the \ref ExecutionKernel.
+     *
+     * This will submit five \ref IOKernel invocations in total, which are executed in order. Those
+     * kernels write the contents of a tile and it's halo to the `in_pipe`.
+     *
+     * \tparam in_pipe The pipe to write the cells to.
+     * \param fpga_queue The configured SYCL queue for submissions.
+     * \param tile_id The id of the tile to read.
+     * \return The events of the submitted kernels, in the order of submission.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref OutOfCoreGrid.get_tile_range.
+     */
+    template <typename in_pipe>
+    std::vector<cl::sycl::event> submit_tile_input(cl::sycl::queue fpga_queue, UID tile_id) {
+        if (tile_id.c >= tile_range.c || tile_id.r >= tile_range.r) {
+            throw std::out_of_range("Tile index out of range");
+        }
+        std::lock_guard<std::recursive_mutex> lock(state->mutex);
+
+        // The outputs need to be in host memory before they are used as inputs.
+        write_back_outputs();
+
+        index_t tile_c = tile_id.c;
+        index_t tile_r = tile_id.r;
+        std::vector<cl::sycl::buffer<T, 2>> buffers;
+        buffers.reserve(25);
+        std::vector<cl::sycl::event> events;
+        events.reserve(5);
+
+        auto submit_column = [&](index_t column_tile_c, Part north_part, Part center_part,
+                                 Part south_part, uindex_t buffer_width) {
+            std::array<cl::sycl::buffer<T, 2>, 5> column{
+                get_input_part(column_tile_c, tile_r - 1, south_part),
+                get_input_part(column_tile_c, tile_r, north_part),
+                get_input_part(column_tile_c, tile_r, center_part),
+                get_input_part(column_tile_c, tile_r, south_part),
+                get_input_part(column_tile_c, tile_r + 1, north_part),
+            };
+            buffers.insert(buffers.end(), column.begin(), column.end());
+            events.push_back(submit_input_kernel<in_pipe>(fpga_queue, column, buffer_width));
+        };
+
+        submit_column(tile_c - 1, Part::NORTH_EAST_CORNER, Part::EAST_BORDER,
+                      Part::SOUTH_EAST_CORNER, halo_radius);
+        submit_column(tile_c, Part::NORTH_WEST_CORNER, Part::WEST_BORDER, Part::SOUTH_WEST_CORNER,
+                      halo_radius);
+        submit_column(tile_c, Part::NORTH_BORDER, Part::CORE, Part::SOUTH_BORDER, core_width);
+        submit_column(tile_c, Part::NORTH_EAST_CORNER, Part::EAST_BORDER, Part::SOUTH_EAST_CORNER,
+                      halo_radius);
+        submit_column(tile_c + 1, Part::NORTH_WEST_CORNER, Part::WEST_BORDER,
+                      Part::SOUTH_WEST_CORNER, halo_radius);
+
+        make_resident(buffers);
+        return events;
+    }
+
+    /**
+     * \brief Submit the output kernels required for one execution of the \ref ExecutionKernel.
+     *
+     * This will submit three \ref IOKernel invocations in total, which are executed in order. Those
+     * kernels will write cells from the `out_pipe` to one of the tiles.
+     *
+     * \tparam out_pipe The pipe to read the cells from.
+     * \param fpga_queue The configured SYCL queue for submissions.
+     * \param tile_id The id of the tile to write to.
+     * \return The events of the submitted kernels, in the order of submission.
+     * \throws std::out_of_range Thrown if the tile id is outside the range of tiles, as returned by
+     * \ref OutOfCoreGrid.get_tile_range.
+     */
+    template <typename out_pipe>
+    std::vector<cl::sycl::event> submit_tile_output(cl::sycl::queue fpga_queue, UID tile_id) {
+        if (tile_id.c >= tile_range.c || tile_id.r >= tile_range.r) {
+            throw std::out_of_range("Tile index out of range");
+        }
+        std::lock_guard<std::recursive_mutex> lock(state->mutex);
+
+        std::vector<cl::sycl::buffer<T, 2>> buffers;
+        buffers.reserve(9);
+        std::vector<cl::sycl::event> events;
+        events.reserve(3);
+
+        auto submit_column = [&](Part north_part, Part center_part, Part south_part,
+                                 uindex_t buffer_width) {
+            std::array<cl::sycl::buffer<T, 2>, 3> column{
+                get_output_part(tile_id, north_part),
+                get_output_part(tile_id, center_part),
+                get_output_part(tile_id, south_part),
+            };
+            buffers.insert(buffers.end(), column.begin(), column.end());
+            events.push_back(submit_output_kernel<out_pipe>(fpga_queue, column, buffer_width));
+        };
+
+        submit_column(Part::NORTH_WEST_CORNER, Part::WEST_BORDER, Part::SOUTH_WEST_CORNER,
+                      halo_radius);
+        submit_column(Part::NORTH_BORDER, Part::CORE, Part::SOUTH_BORDER, core_width);
+        submit_column(Part::NORTH_EAST_CORNER, Part::EAST_BORDER, Part::SOUTH_EAST_CORNER,
+                      halo_radius);
+
+        state->has_pending_outputs = true;
+        make_resident(buffers);
+        return events;
+    }
+
+  private:
+    static constexpr uindex_t core_height = tile_height - 2 * halo_radius;
+    static constexpr uindex_t core_width = tile_width - 2 * halo_radius;
+
+    /**
+     * \brief The shared state of all copies of a grid.
+     *
+     * The buffers are declared after the cells since they may write back to the cells when they
+     * are destroyed.
+     */
+    struct State {
+        std::shared_ptr<T> cells;
+        std::deque<std::vector<cl::sycl::buffer<T, 2>>> resident_buffers;
+        std::optional<cl::sycl::buffer<T, 2>> halo_parts[9];
+        bool has_pending_outputs = false;
+        std::recursive_mutex mutex;
+    };
+
+    static uindex_t div_ceil(uindex_t a, uindex_t b) { return a / b + (a % b == 0 ? 0 : 1); }
+
+    static std::shared_ptr<T> allocate_cells(uindex_t n_cells,
+                                             std::optional<std::string> const &swap_directory) {
+        if (n_cells == 0) {
+            return std::shared_ptr<T>();
+        }
+        size_t n_bytes = n_cells * sizeof(T);
+
+        int fd = -1;
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        if (swap_directory.has_value()) {
+            std::string path_template = *swap_directory + "/StencilStream.XXXXXX";
+            std::vector<char> path(path_template.begin(), path_template.end());
+            path.push_back('\0');
+
+            fd = mkstemp(path.data());
+            if (fd == -1) {
+                throw std::runtime_error(std::string("Could not create the swap file: ") +
+                                         std::strerror(errno));
+            }
+            unlink(path.data());
+            if (ftruncate(fd, n_bytes) != 0) {
+                close(fd);
+                throw std::runtime_error(std::string("Could not resize the swap file: ") +
+                                         std::strerror(errno));
+            }
+            flags = MAP_SHARED;
+        }
+
+        void *cells = mmap(nullptr, n_bytes, PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (fd != -1) {
+            close(fd);
+        }
+        if (cells == MAP_FAILED) {
+            throw std::runtime_error(std::string("Could not map the grid memory: ") +
+                                     std::strerror(errno));
+        }
+
+        return std::shared_ptr<T>(static_cast<T *>(cells),
+                                  [n_bytes](T *cells) { munmap(cells, n_bytes); });
+    }
+
+    static cl::sycl::range<2> get_part_buffer_range(Part part) {
+        cl::sycl::range<2> part_range = TileImpl::get_part_range(part);
+        return burst_partitioned_range(part_range[0], part_range[1], burst_length);
+    }
+
+    cl::sycl::buffer<T, 2> get_input_part(index_t tile_c, index_t tile_r, Part part) {
+        if (tile_c < 0 || tile_r < 0 || tile_c >= index_t(tile_range.c) ||
+            tile_r >= index_t(tile_range.r)) {
+            // The part is outside of the grid, so its contents are never used.
+            std::optional<cl::sycl::buffer<T, 2>> &halo_part = state->halo_parts[uindex_t(part)];
+            if (!halo_part.has_value()) {
+                halo_part = cl::sycl::buffer<T, 2>(get_part_buffer_range(part));
+            }
+            return *halo_part;
+        }
+
+        T const *part_cells = get_tile_cells(UID(tile_c, tile_r)) + get_part_cell_offset(part);
+        return cl::sycl::buffer<T, 2>(part_cells, get_part_buffer_range(part));
+    }
+
+    cl::sycl::buffer<T, 2> get_output_part(UID tile_id, Part part) {
+        T *part_cells = get_tile_cells(tile_id) + get_part_cell_offset(part);
+        return cl::sycl::buffer<T, 2>(part_cells, get_part_buffer_range(part));
+    }
+
+    void make_resident(std::vector<cl::sycl::buffer<T, 2>> buffers) {
+        state->resident_buffers.push_back(buffers);
+        while (state->resident_buffers.size() > n_resident_tiles) {
+            // Destroying the buffers blocks this thread until their kernels have completed and
+            // the outputs are written back.
+            state->resident_buffers.pop_front();
+        }
+    }
+
+    T &get_cell(UID cell) {
+        UID tile_id(cell.c / tile_width, cell.r / tile_height);
+        uindex_t c = cell.c % tile_width;
+        uindex_t r = cell.r % tile_height;
+
+        uindex_t part_column = c < halo_radius ? 0 : (c < tile_width - halo_radius ? 1 : 2);
+        uindex_t part_row = r < halo_radius ? 0 : (r < tile_height - halo_radius ? 1 : 2);
+        constexpr Part parts[3][3] = {
+            {Part::NORTH_WEST_CORNER, Part::WEST_BORDER, Part::SOUTH_WEST_CORNER},
+            {Part::NORTH_BORDER, Part::CORE, Part::SOUTH_BORDER},
+            {Part::NORTH_EAST_CORNER, Part::EAST_BORDER, Part::SOUTH_EAST_CORNER},
+        };
+        Part part = parts[part_column][part_row];
+
+        cl::sycl::id<2> part_offset = TileImpl::get_part_offset(part);
+        uindex_t part_height = TileImpl::get_part_range(part)[1];
+        return get_tile_cells(tile_id)[get_part_cell_offset(part) +
+                                       (c - part_offset[0]) * part_height + (r - part_offset[1])];
+    }
+
+    template <typename Action> void for_each_cell(Action action) {
+        for (uindex_t tile_c = 0; tile_c < tile_range.c; tile_c++) {
+            for (uindex_t tile_r = 0; tile_r < tile_range.r; tile_r++) {
+                T *tile_cells = get_tile_cells(UID(tile_c, tile_r));
+                for (Part part : TileImpl::all_parts) {
+                    T *part_cells = tile_cells + get_part_cell_offset(part);
+                    cl::sycl::range<2> part_range = TileImpl::get_part_range(part);
+                    cl::sycl::id<2> part_offset = TileImpl::get_part_offset(part);
+
+                    for (uindex_t c = 0; c < part_range[0]; c++) {
+                        uindex_t grid_c = tile_c * tile_width + part_offset[0] + c;
+                        for (uindex_t r = 0; r < part_range[1]; r++) {
+                            uindex_t grid_r = tile_r * tile_height + part_offset[1] + r;
+                            if (grid_c < grid_range[0] && grid_r < grid_range[1]) {
+                                action(grid_c, grid_r, part_cells[c * part_range[1] + r]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void copy_from(cl::sycl::buffer<T, 2> in_buffer) {
+        auto ac = in_buffer.template get_access<cl::sycl::access::mode::read>();
+        for_each_cell([&](uindex_t c, uindex_t r, T &cell) { cell = ac[c][r]; });
+    }
+
+    template <typename pipe>
+    cl::sycl::event submit_input_kernel(cl::sycl::queue fpga_queue,
+                                        std::array<cl::sycl::buffer<T, 2>, 5> buffer,
+                                        uindex_t buffer_width) {
+        using InputKernel = IOKernel<T, halo_radius, core_height, burst_length, pipe, 2,
+                                     cl::sycl::access::mode::read>;
+
+        return fpga_queue.submit([&](cl::sycl::handler &cgh) {
+            std::array<typename InputKernel::Accessor, 5> accessor{
+                buffer[0].template get_access<cl::sycl::access::mode::read>(cgh),
+                buffer[1].template get_access<cl::sycl::access::mode::read>(cgh),
+                buffer[2].template get_access<cl::sycl::access::mode::read>(cgh),
+                buffer[3].template get_access<cl::sycl::access::mode::read>(cgh),
+                buffer[4].template get_access<cl::sycl::access::mode::read>(cgh),
+            };
+
+            cgh.single_task<class OutOfCoreInputKernelLambda>(
+                [=]() { InputKernel(accessor, buffer_width).read(); });
+        });
+    }
+
+    template <typename pipe>
+    cl::sycl::event submit_output_kernel(cl::sycl::queue fpga_queue,
+                                         std::array<cl::sycl::buffer<T, 2>, 3> buffer,
+                                         uindex_t buffer_width) {
+        using OutputKernel = IOKernel<T, halo_radius, core_height, burst_length, pipe, 1,
+                                      cl::sycl::access::mode::discard_write>;
+
+        return fpga_queue.submit([&](cl::sycl::handler &cgh) {
+            std::array<typename OutputKernel::Accessor, 3> accessor{
+                buffer[0].template get_access<cl::sycl::access::mode::discard_write>(cgh),
+                buffer[1].template get_access<cl::sycl::access::mode::discard_write>(cgh),
+                buffer[2].template get_access<cl::sycl::access::mode::discard_write>(cgh),
+            };
+
+            cgh.single_task<class OutOfCoreOutputKernelLambda>(
+                [=]() { OutputKernel(accessor, buffer_width).write(); });
+        });
+    }
+
+    std::shared_ptr<State> state;
+    cl::sycl::range<2> grid_range;
+    UID tile_range;
+    std::optional<std::string> swap_directory;
+    uindex_t n_resident_tiles;
+};
+
+} // namespace tiling
+} // namespace stencil
@@ -22,6 +22,7 @@
 #include <StencilStream/Index.hpp>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <unistd.h>
 
 using namespace std;
@@ -86,6 +87,7 @@ Operation Parameters:\n\
 -h:         Print this help message and exit.\n\
 -o <path>:  Directory for output files (default: \".\").\n\
 -i <float>: Write a snapshot of the magnetic field to the output directory every x multiples of tau (default: disabled).\n\
+-n <int>:   Only write every n-th cell in every direction to the snapshots (default: 1).\n\
 ";
 
 struct FDTDCell {
@@ -101,12 +103,14 @@ struct Material {
 };
 
 struct Parameters {
-    Parameters(int argc, char **argv)
+    Parameters()
         : t_cutoff_factor(7.0), t_detect_factor(14.0), t_max_factor(15.0), frequency(120e12),
           t_0_factor(3.0), disk_radius(800e-9), dx(10e-9), tau(100e-15), out_dir("."),
-          interval_factor(std::nullopt) {
+          interval_factor(std::nullopt), frame_stride(1) {}
+
+    Parameters(int argc, char **argv) : Parameters() {
         int c;
-        while ((c = getopt(argc, argv, "hc:d:e:f:p:r:s:t:o:i:")) != -1) {
+        while ((c = getopt(argc, argv, "hc:d:e:f:p:r:s:t:o:i:n:")) != -1) {
             switch (c) {
             case 'c':
                 t_cutoff_factor = stof(optarg);
@@ -171,6 +175,13 @@ struct Parameters {
             case 'i':
                 interval_factor = stof(optarg);
                 break;
+            case 'n':
+                frame_stride = stoi(optarg);
+                if (frame_stride < 1) {
+                    cerr << "Error: The snapshot stride must be at least 1" << std::endl;
+                    exit(1);
+                }
+                break;
             case 'h':
             case '?':
             default:
@@ -200,6 +211,8 @@ struct Parameters {
 
     std::optional<float> interval_factor;
 
+    int frame_stride;
+
     float t_cutoff() const { return t_cutoff_factor * tau; }
 
     float t_detect() const { return t_detect_factor * tau; }
@@ -232,6 +245,11 @@ struct Parameters {
         return vacuum;
     }
 
+    cl::sycl::range<2> frame_range() const {
+        return cl::sycl::range<2>((grid_range()[0] + frame_stride - 1) / frame_stride,
+                                  (grid_range()[1] + frame_stride - 1) / frame_stride);
+    }
+
     std::optional<uindex_t> interval() const {
         if (interval_factor.has_value()) {
             return uindex_t(std::ceil((*interval_factor * tau) / dt()));
@@ -147,6 +147,21 @@ int main(int argc, char **argv) {
 
     Executor executor(FDTDKernel::halo(), FDTDKernel(parameters));
     executor.set_input(grid_buffer);
+
+#ifndef MONOTILE
+    // Only the cells inside the disk are altered by the transition function.
+    cl::sycl::buffer<bool, 2> domain_mask(parameters.grid_range());
+    {
+        auto grid_ac = grid_buffer.get_access<cl::sycl::access::mode::read>();
+        auto mask_ac = domain_mask.get_access<cl::sycl::access::mode::discard_write>();
+        for (uindex_t c = 0; c < parameters.grid_range()[0]; c++) {
+            for (uindex_t r = 0; r < parameters.grid_range()[1]; r++) {
+                mask_ac[c][r] = grid_ac[c][r].distance < parameters.disk_radius;
+            }
+        }
+    }
+    executor.set_domain_mask(domain_mask);
+#endif
     executor.set_queue(fpga_queue);
 
     uindex_t n_timesteps = parameters.n_timesteps();
@@ -155,17 +170,20 @@ int main(int argc, char **argv) {
     if (parameters.interval().has_value()) {
         uindex_t interval = 2 * *(parameters.interval());
         double runtime = 0.0;
+        cl::sycl::buffer<FDTDCell, 2> frame_buffer(parameters.frame_range());
+        UID grid_range(parameters.grid_range()[0], parameters.grid_range()[1]);
+        UID frame_stride(parameters.frame_stride, parameters.frame_stride);
 
         while (executor.get_i_generation() + interval < n_timesteps) {
             executor.run(interval);
-            executor.copy_output(grid_buffer);
+            executor.copy_output(frame_buffer, UID(0, 0), grid_range, frame_stride);
 
             uindex_t i_generation = executor.get_i_generation();
-            save_frame(grid_buffer, i_generation, CellField::EX, parameters);
-            save_frame(grid_buffer, i_generation, CellField::EY, parameters);
-            save_frame(grid_buffer, i_generation, CellField::HZ, parameters);
-            save_frame(grid_buffer, i_generation, CellField::HZ_SUM, parameters);
-            save_frame(grid_buffer, i_generation, CellField::DISTANCE, parameters);
+            save_frame(frame_buffer, i_generation, CellField::EX, parameters);
+            save_frame(frame_buffer, i_generation, CellField::EY, parameters);
+            save_frame(frame_buffer, i_generation, CellField::HZ, parameters);
+            save_frame(frame_buffer, i_generation, CellField::HZ_SUM, parameters);
+            save_frame(frame_buffer, i_generation, CellField::DISTANCE, parameters);
 
             runtime += executor.get_runtime_sample().get_total_runtime();
             double progress = 100.0 * (double(i_generation) / double(n_timesteps));
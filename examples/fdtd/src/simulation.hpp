@@ -20,8 +20,45 @@
 #pragma once
 #include "defines.hpp"
 #include <StencilStream/Stencil.hpp>
+#include <StencilStream/TransFuncSequence.hpp>
+#include <cmath>
 
-class FDTDKernel {
+/**
+ * The update of the electric field, which is computed in even generations.
+ */
+class EUpdate {
+    float disk_radius;
+    Material vacuum;
+
+  public:
+    EUpdate(Parameters const &parameters)
+        : disk_radius(parameters.disk_radius), vacuum(parameters.vacuum()) {}
+
+    /**
+     * The E-field update only reads the central cell and its northern and western neighbors.
+     */
+    static constexpr bool accesses(index_t c, index_t r) {
+        return (c == 0 && r <= 0 && r >= -1) || (r == 0 && c == -1);
+    }
+
+    FDTDCell operator()(Stencil<FDTDCell, stencil_radius> const &stencil) const {
+        FDTDCell cell = stencil[ID(0, 0)];
+
+        if (cell.distance < disk_radius) {
+            cell.ex *= vacuum.ca;
+            cell.ex += vacuum.cb * (stencil[ID(0, 0)].hz - stencil[ID(0, -1)].hz);
+
+            cell.ey *= vacuum.ca;
+            cell.ey += vacuum.cb * (stencil[ID(-1, 0)].hz - stencil[ID(0, 0)].hz);
+        }
+        return cell;
+    }
+};
+
+/**
+ * The update of the magnetic field, which is computed in odd generations.
+ */
+class HUpdate {
     float disk_radius;
     float tau;
     float omega;
@@ -33,48 +70,77 @@ class FDTDKernel {
     Material vacuum;
 
   public:
-    FDTDKernel(Parameters const &parameters)
+    HUpdate(Parameters const &parameters)
         : disk_radius(parameters.disk_radius), tau(parameters.tau), omega(parameters.omega()),
           t_0(parameters.t_0()), t_cutoff(parameters.t_cutoff()), t_detect(parameters.t_detect()),
           dx(parameters.dx), dt(parameters.dt()), vacuum(parameters.vacuum()) {}
 
-    static FDTDCell halo() {
-        FDTDCell new_cell;
-        new_cell.ex = 0;
-        new_cell.ey = 0;
-        new_cell.hz = 0;
-        new_cell.hz_sum = 0;
-        new_cell.distance = INFINITY;
-        return new_cell;
+    /**
+     * The values of the H-field update that only depend on the generation index. They are computed
+     * once per kernel submission on the host instead of once per cell.
+     */
+    struct Uniform {
+        bool source_active;
+        float source_value;
+        bool detect;
+    };
+
+    Uniform get_uniform(uindex_t i_generation) const {
+        float current_time = (i_generation >> 1) * dt;
+        float wave_progress = (current_time - t_0) / tau;
+
+        Uniform uniform;
+        uniform.source_active = current_time < t_cutoff;
+        uniform.source_value =
+            std::cos(omega * current_time) * std::exp(-1 * wave_progress * wave_progress);
+        uniform.detect = current_time > t_detect;
+        return uniform;
     }
 
-    FDTDCell operator()(Stencil<FDTDCell, stencil_radius> const &stencil) const {
+    /**
+     * The H-field update only reads the central cell and its southern and eastern neighbors.
+     */
+    static constexpr bool accesses(index_t c, index_t r) {
+        return (c == 0 && r >= 0 && r <= 1) || (r == 0 && c == 1);
+    }
+
+    FDTDCell operator()(Stencil<FDTDCell, stencil_radius> const &stencil,
+                        Uniform const &uniform) const {
         FDTDCell cell = stencil[ID(0, 0)];
 
         if (cell.distance < disk_radius) {
-            if ((stencil.stage & 0b1) == 0) {
-                cell.ex *= vacuum.ca;
-                cell.ex += vacuum.cb * (stencil[ID(0, 0)].hz - stencil[ID(0, -1)].hz);
-
-                cell.ey *= vacuum.ca;
-                cell.ey += vacuum.cb * (stencil[ID(-1, 0)].hz - stencil[ID(0, 0)].hz);
-            } else {
-                cell.hz *= vacuum.da;
-                cell.hz += vacuum.db * (stencil[ID(0, 1)].ex - stencil[ID(0, 0)].ex +
-                                        stencil[ID(0, 0)].ey - stencil[ID(1, 0)].ey);
-
-                float current_time = (stencil.generation >> 1) * dt;
-                if (cell.distance < dx && current_time < t_cutoff) {
-                    float wave_progress = (current_time - t_0) / tau;
-                    cell.hz += cl::sycl::cos(omega * current_time) *
-                               cl::sycl::exp(-1 * wave_progress * wave_progress);
-                }
-
-                if (current_time > t_detect) {
-                    cell.hz_sum += cell.hz * cell.hz;
-                }
+            cell.hz *= vacuum.da;
+            cell.hz += vacuum.db * (stencil[ID(0, 1)].ex - stencil[ID(0, 0)].ex +
+                                    stencil[ID(0, 0)].ey - stencil[ID(1, 0)].ey);
+
+            if (cell.distance < dx && uniform.source_active) {
+                cell.hz += uniform.source_value;
+            }
+
+            if (uniform.detect) {
+                cell.hz_sum += cell.hz * cell.hz;
             }
         }
         return cell;
     }
-};
\ No newline at end of file
+};
+
+/**
+ * The FDTD transition function, which alternates between the E- and the H-field update. Every
+ * pipeline stage is synthesized from only one of them.
+ */
+class FDTDKernel : public TransFuncSequence<EUpdate, HUpdate> {
+  public:
+    FDTDKernel(Parameters const &parameters)
+        : TransFuncSequence<EUpdate, HUpdate>(EUpdate(parameters), HUpdate(parameters)) {}
+
+    static FDTDCell halo() {
+        FDTDCell new_cell;
+        new_cell.ex = 0;
+        new_cell.ey = 0;
+        new_cell.hz = 0;
+        new_cell.hz_sum = 0;
+        new_cell.distance = INFINITY;
+        return new_cell;
+    }
+};
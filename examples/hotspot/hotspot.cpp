@@ -17,6 +17,7 @@
  * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include "hotspot.hpp"
 #include <CL/sycl.hpp>
 #include <CL/sycl/INTEL/fpga_extensions.hpp>
 #include <StencilStream/MonotileExecutor.hpp>
@@ -27,27 +28,11 @@ using namespace std;
 using namespace cl::sycl;
 using namespace stencil;
 
-typedef float FLOAT;
-
-/* maximum power density possible (say 300W for a 10mm x 10mm chip)	*/
-#define MAX_PD (3.0e6)
-/* required precision in degrees	*/
-#define PRECISION 0.001
-#define SPEC_HEAT_SI 1.75e6
-#define K_SI 100
-/* capacitance fitting factor	*/
-#define FACTOR_CHIP 0.5
-
-/* chip parameters	*/
-const FLOAT t_chip = 0.0005;
-const FLOAT chip_height = 0.016;
-const FLOAT chip_width = 0.016;
-
-/* ambient temperature, assuming no package at all	*/
-const FLOAT amb_temp = 80.0;
+typedef HotspotKernel::FLOAT FLOAT;
+using Cell = HotspotKernel::Cell;
 
 /* stencil parameters */
-const uindex_t stencil_radius = 1;
+const uindex_t stencil_radius = HotspotKernel::stencil_radius;
 const uindex_t pipeline_length = 32;
 const uindex_t tile_width = 1024;
 const uindex_t tile_height = 1024;
@@ -59,8 +44,6 @@ using selector = INTEL::fpga_selector;
 using selector = INTEL::fpga_emulator_selector;
 #endif
 
-using Cell = vec<FLOAT, 2>;
-
 void write_output(buffer<Cell, 2> vect, string file) {
     fstream out(file, out.out | out.trunc);
     if (!out.is_open()) {
@@ -145,61 +128,13 @@ double run_simulation(cl::sycl::queue working_queue, buffer<Cell, 2> temp, uinde
     uindex_t n_columns = temp.get_range()[0];
     uindex_t n_rows = temp.get_range()[1];
 
-    FLOAT grid_height = chip_height / n_rows;
-    FLOAT grid_width = chip_width / n_columns;
-
-    FLOAT Cap = FACTOR_CHIP * SPEC_HEAT_SI * t_chip * grid_width * grid_height;
-    FLOAT Rx = grid_width / (2.0 * K_SI * t_chip * grid_height);
-    FLOAT Ry = grid_height / (2.0 * K_SI * t_chip * grid_width);
-    FLOAT Rz = t_chip / (K_SI * grid_height * grid_width);
-
-    FLOAT max_slope = MAX_PD / (FACTOR_CHIP * t_chip * SPEC_HEAT_SI);
-    FLOAT step = PRECISION / max_slope / 1000.0;
-
-    FLOAT Rx_1 = 1.f / Rx;
-    FLOAT Ry_1 = 1.f / Ry;
-    FLOAT Rz_1 = 1.f / Rz;
-    FLOAT Cap_1 = step / Cap;
-
-    auto kernel = [=](Stencil<Cell, stencil_radius> const &temp) {
-        ID idx = temp.id;
-        index_t c = idx.c;
-        index_t r = idx.r;
-        uindex_t width = temp.grid_range.c;
-        uindex_t height = temp.grid_range.r;
-
-        FLOAT power = temp[ID(0, 0)][1];
-        FLOAT old = temp[ID(0, 0)][0];
-        FLOAT left = temp[ID(-1, 0)][0];
-        FLOAT right = temp[ID(1, 0)][0];
-        FLOAT top = temp[ID(0, -1)][0];
-        FLOAT bottom = temp[ID(0, 1)][0];
-
-        if (c == 0) {
-            left = old;
-        } else if (c == width - 1) {
-            right = old;
-        }
-
-        if (r == 0) {
-            top = old;
-        } else if (r == height - 1) {
-            bottom = old;
-        }
-
-        // As in the OpenCL version of the rodinia "hotspot" benchmark.
-        FLOAT new_temp =
-            old + Cap_1 * (power + (bottom + top - 2.f * old) * Ry_1 +
-                           (right + left - 2.f * old) * Rx_1 + (amb_temp - old) * Rz_1);
-
-        return vec(new_temp, power);
-    };
+    HotspotKernel kernel(n_columns, n_rows);
 
 #ifdef MONOTILE
-    using Executor = MonotileExecutor<Cell, stencil_radius, decltype(kernel), pipeline_length,
+    using Executor = MonotileExecutor<Cell, stencil_radius, HotspotKernel, pipeline_length,
                                       tile_width, tile_height>;
 #else
-    using Executor = StencilExecutor<Cell, stencil_radius, decltype(kernel), pipeline_length,
+    using Executor = StencilExecutor<Cell, stencil_radius, HotspotKernel, pipeline_length,
                                      tile_width, tile_height, burst_size>;
 #endif
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include <CL/sycl.hpp>
+#include <StencilStream/GenericID.hpp>
+#include <StencilStream/Index.hpp>
+#include <StencilStream/Stencil.hpp>
+
+/**
+ * The transition function of the rodinia "hotspot" benchmark. The coefficients of the heat
+ * transfer depend on the size of the grid.
+ */
+class HotspotKernel {
+  public:
+    using FLOAT = float;
+
+    /* temperature and dissipated power of a cell */
+    using Cell = cl::sycl::vec<FLOAT, 2>;
+
+    static constexpr stencil::uindex_t stencil_radius = 1;
+
+    /* maximum power density possible (say 300W for a 10mm x 10mm chip)	*/
+    static constexpr double max_pd = 3.0e6;
+    /* required precision in degrees	*/
+    static constexpr double precision = 0.001;
+    static constexpr double spec_heat_si = 1.75e6;
+    static constexpr int k_si = 100;
+    /* capacitance fitting factor	*/
+    static constexpr double factor_chip = 0.5;
+
+    /* chip parameters	*/
+    static constexpr FLOAT t_chip = 0.0005;
+    static constexpr FLOAT chip_height = 0.016;
+    static constexpr FLOAT chip_width = 0.016;
+
+    /* ambient temperature, assuming no package at all	*/
+    static constexpr FLOAT amb_temp = 80.0;
+
+    HotspotKernel(stencil::uindex_t n_columns, stencil::uindex_t n_rows) {
+        FLOAT grid_height = chip_height / n_rows;
+        FLOAT grid_width = chip_width / n_columns;
+
+        FLOAT Cap = factor_chip * spec_heat_si * t_chip * grid_width * grid_height;
+        FLOAT Rx = grid_width / (2.0 * k_si * t_chip * grid_height);
+        FLOAT Ry = grid_height / (2.0 * k_si * t_chip * grid_width);
+        FLOAT Rz = t_chip / (k_si * grid_height * grid_width);
+
+        FLOAT max_slope = max_pd / (factor_chip * t_chip * spec_heat_si);
+        FLOAT step = precision / max_slope / 1000.0;
+
+        Rx_1 = 1.f / Rx;
+        Ry_1 = 1.f / Ry;
+        Rz_1 = 1.f / Rz;
+        Cap_1 = step / Cap;
+    }
+
+    Cell operator()(stencil::Stencil<Cell, stencil_radius> const &temp) const {
+        stencil::ID idx = temp.id;
+        stencil::index_t c = idx.c;
+        stencil::index_t r = idx.r;
+        stencil::uindex_t width = temp.grid_range.c;
+        stencil::uindex_t height = temp.grid_range.r;
+
+        FLOAT power = temp[stencil::ID(0, 0)][1];
+        FLOAT old = temp[stencil::ID(0, 0)][0];
+        FLOAT left = temp[stencil::ID(-1, 0)][0];
+        FLOAT right = temp[stencil::ID(1, 0)][0];
+        FLOAT top = temp[stencil::ID(0, -1)][0];
+        FLOAT bottom = temp[stencil::ID(0, 1)][0];
+
+        if (c == 0) {
+            left = old;
+        } else if (c == width - 1) {
+            right = old;
+        }
+
+        if (r == 0) {
+            top = old;
+        } else if (r == height - 1) {
+            bottom = old;
+        }
+
+        // As in the OpenCL version of the rodinia "hotspot" benchmark.
+        FLOAT new_temp =
+            old + Cap_1 * (power + (bottom + top - 2.f * old) * Ry_1 +
+                           (right + left - 2.f * old) * Rx_1 + (amb_temp - old) * Rz_1);
+
+        return Cell(new_temp, power);
+    }
+
+  private:
+    FLOAT Rx_1, Ry_1, Rz_1, Cap_1;
+};
@@ -0,0 +1,569 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <CL/sycl.hpp>
+#include <CL/sycl/INTEL/fpga_extensions.hpp>
+#include <StencilStream/BitPackedExecutor.hpp>
+#include <StencilStream/HostExecutor.hpp>
+#include <StencilStream/MonotileExecutor.hpp>
+#include <StencilStream/SkewedExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <chrono>
+#include <examples/fdtd/src/simulation.hpp>
+#include <examples/hotspot/hotspot.hpp>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+using namespace cl::sycl;
+using namespace stencil;
+
+/*
+ * Benchmark kernels.
+ *
+ * Every kernel defines its cell type, its stencil radius, its halo value and the initial value of
+ * every cell. The kernels are constructed with the grid range since some of their coefficients
+ * depend on it. The transition functions are the ones of the library and of the examples, so that
+ * the benchmark measures the code that is actually used.
+ */
+
+class ConwayBench : public LifeLikeRule {
+  public:
+    using Cell = bool;
+    static constexpr uindex_t stencil_radius = 1;
+    static constexpr char const *name = "conway";
+
+    ConwayBench(uindex_t, uindex_t) : LifeLikeRule(LifeLikeRule::conway()) {}
+
+    static Cell halo() { return false; }
+
+    Cell initial_value(uindex_t c, uindex_t r) const { return (c * 7 + r * 13) % 5 < 2; }
+};
+
+class HotspotBench : public HotspotKernel {
+  public:
+    static constexpr char const *name = "hotspot";
+
+    HotspotBench(uindex_t grid_width, uindex_t grid_height)
+        : HotspotKernel(grid_width, grid_height) {}
+
+    static Cell halo() { return Cell(0.0f, 0.0f); }
+
+    Cell initial_value(uindex_t c, uindex_t r) const {
+        return Cell(320.0f + float((c + r) % 16), float((c * r) % 8) * 1e-3f);
+    }
+};
+
+// A disk cavity that fills the whole grid, with the default parameters of examples/fdtd otherwise.
+class FDTDBench : public FDTDKernel {
+  public:
+    using Cell = FDTDCell;
+    static constexpr uindex_t stencil_radius = 1;
+    static constexpr char const *name = "fdtd";
+
+    FDTDBench(uindex_t grid_width, uindex_t grid_height)
+        : FDTDKernel(get_parameters(grid_width, grid_height)), cell_size(Parameters().dx),
+          center_c(float(grid_width) / 2.0), center_r(float(grid_height) / 2.0) {}
+
+    Cell initial_value(uindex_t c, uindex_t r) const {
+        Cell cell = halo();
+        float a = float(c) - center_c;
+        float b = float(r) - center_r;
+        cell.distance = cell_size * std::sqrt(a * a + b * b);
+        return cell;
+    }
+
+  private:
+    static Parameters get_parameters(uindex_t grid_width, uindex_t grid_height) {
+        Parameters parameters;
+        parameters.disk_radius = parameters.dx * float(std::min(grid_width, grid_height) - 2) / 2.0;
+        return parameters;
+    }
+
+    float cell_size, center_c, center_r;
+};
+
+/*
+ * Benchmark harness.
+ */
+
+// The tile orders of the StencilExecutor by name. Column-major is the default order and is
+// reported as "StencilExecutor", the other orders as "StencilExecutor/<name>".
+std::map<std::string, TileOrder> const tile_orders = {
+    {"column-major", TileOrder::COLUMN_MAJOR},
+    {"row-major", TileOrder::ROW_MAJOR},
+    {"z-order", TileOrder::Z_ORDER},
+    {"snake", TileOrder::SNAKE},
+};
+
+struct BenchOptions {
+    std::vector<uindex_t> grid_sizes = {256, 1024};
+    std::vector<std::string> tile_orders = {"column-major", "row-major", "z-order", "snake"};
+    uindex_t n_generations = 64;
+    std::string format = "csv";
+    std::string output_path = "";
+    std::string baseline_path = "";
+    double tolerance = 0.05;
+};
+
+struct BenchResult {
+    std::string executor;
+    std::string kernel;
+    uindex_t pipeline_length;
+    uindex_t tile_width;
+    uindex_t tile_height;
+    uindex_t grid_width;
+    uindex_t grid_height;
+    uindex_t n_generations;
+    double runtime;
+    // The fraction of the computed cell updates that is not part of the result, as predicted by
+    // the executor's performance model.
+    double redundancy;
+
+    std::string get_key() const {
+        std::stringstream key;
+        key << executor << "," << kernel << "," << pipeline_length << "," << tile_width << ","
+            << tile_height << "," << grid_width << "," << grid_height;
+        return key.str();
+    }
+
+    double get_cells_per_second() const {
+        return double(grid_width) * grid_height * n_generations / runtime;
+    }
+
+    double get_generations_per_second() const { return n_generations / runtime; }
+};
+
+// Executors that submit their kernels to a SYCL queue. The host executor runs synchronously.
+template <typename Executor, typename = void> struct has_queue : std::false_type {};
+
+template <typename Executor>
+struct has_queue<Executor, std::void_t<decltype(std::declval<Executor &>().get_queue())>>
+    : std::true_type {};
+
+// Executors that process the tiles of a pass in a configurable order.
+template <typename Executor, typename = void> struct has_tile_order : std::false_type {};
+
+template <typename Executor>
+struct has_tile_order<Executor, std::void_t<decltype(std::declval<Executor &>().set_tile_order(
+                                    TileOrder::COLUMN_MAJOR))>> : std::true_type {};
+
+template <typename Executor> struct BenchModel {
+    static double get_redundancy(uindex_t grid_width, uindex_t grid_height) {
+        return Executor::PerformanceModel::predict_pass(grid_width, grid_height).get_redundancy();
+    }
+};
+
+// The bit-packed executor processes words of cells with a regular StencilExecutor.
+template <typename word_t, uindex_t pipeline_length, uindex_t tile_width, uindex_t tile_height,
+          uindex_t burst_size>
+struct BenchModel<BitPackedExecutor<word_t, pipeline_length, tile_width, tile_height, burst_size>> {
+    using Executor =
+        BitPackedExecutor<word_t, pipeline_length, tile_width, tile_height, burst_size>;
+
+    static double get_redundancy(uindex_t grid_width, uindex_t grid_height) {
+        uindex_t n_words = (grid_height + Executor::word_bits - 1) / Executor::word_bits;
+        return Executor::PackedExecutorImpl::PerformanceModel::predict_pass(grid_width, n_words)
+            .get_redundancy();
+    }
+};
+
+template <typename Executor> void wait_for(Executor &executor) {
+    if constexpr (has_queue<Executor>::value) {
+        executor.get_queue().wait();
+    }
+}
+
+template <typename Executor, typename Kernel>
+BenchResult run_benchmark(std::string executor_name, uindex_t pipeline_length, uindex_t tile_width,
+                          uindex_t tile_height, uindex_t grid_width, uindex_t grid_height,
+                          uindex_t n_generations,
+                          std::function<void(Executor &)> configure = [](Executor &) {}) {
+    using Cell = typename Kernel::Cell;
+
+    Kernel kernel(grid_width, grid_height);
+    buffer<Cell, 2> input_buffer(range<2>(grid_width, grid_height));
+    {
+        auto input_ac = input_buffer.template get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                input_ac[c][r] = kernel.initial_value(c, r);
+            }
+        }
+    }
+
+    Executor executor(Kernel::halo(), kernel);
+    if constexpr (has_queue<Executor>::value) {
+#ifdef HARDWARE
+        executor.select_fpga(false);
+#else
+        executor.select_emulator(false);
+#endif
+    }
+    configure(executor);
+    executor.set_input(input_buffer);
+
+    // Warm up, so that the device initialization and the bitstream loading are not measured.
+    executor.run(pipeline_length);
+    wait_for(executor);
+
+    auto start = std::chrono::steady_clock::now();
+    executor.run(n_generations);
+    wait_for(executor);
+    auto end = std::chrono::steady_clock::now();
+
+    return BenchResult{executor_name,
+                       Kernel::name,
+                       pipeline_length,
+                       tile_width,
+                       tile_height,
+                       grid_width,
+                       grid_height,
+                       n_generations,
+                       std::chrono::duration<double>(end - start).count(),
+                       BenchModel<Executor>::get_redundancy(grid_width, grid_height)};
+}
+
+// Run an executor once, or once for every selected tile order if it supports them.
+template <typename Executor, typename Kernel, uindex_t pipeline_length, uindex_t tile_width,
+          uindex_t tile_height>
+void bench_executor(std::string executor_name, uindex_t grid_size, BenchOptions const &options,
+                    std::vector<BenchResult> &results) {
+    if constexpr (has_tile_order<Executor>::value) {
+        for (std::string const &order_name : options.tile_orders) {
+            TileOrder order = tile_orders.at(order_name);
+            results.push_back(run_benchmark<Executor, Kernel>(
+                order == TileOrder::COLUMN_MAJOR ? executor_name
+                                                 : executor_name + "/" + order_name,
+                pipeline_length, tile_width, tile_height, grid_size, grid_size,
+                options.n_generations,
+                [order](Executor &executor) { executor.set_tile_order(order); }));
+        }
+    } else {
+        results.push_back(run_benchmark<Executor, Kernel>(executor_name, pipeline_length,
+                                                          tile_width, tile_height, grid_size,
+                                                          grid_size, options.n_generations));
+    }
+}
+
+template <typename Kernel, uindex_t pipeline_length, uindex_t tile_width, uindex_t tile_height>
+void print_configuration(uindex_t grid_size) {
+    std::cerr << Kernel::name << ", pipeline length " << pipeline_length << ", tile " << tile_width
+              << "x" << tile_height << ", grid " << grid_size << "x" << grid_size << std::endl;
+}
+
+#ifdef BENCH_EXECUTOR
+
+/*
+ * A single configuration, selected with the following macros:
+ *
+ * BENCH_KERNEL: ConwayBench, HotspotBench or FDTDBench.
+ * BENCH_EXECUTOR: StencilExecutor, SkewedExecutor or MonotileExecutor.
+ * BENCH_PIPELINE_LENGTH, BENCH_TILE_WIDTH, BENCH_TILE_HEIGHT: The parameters of the executor.
+ *
+ * Hardware builds have to select a single configuration: Every executor of a build is synthesized
+ * into the same bitstream, which would not fit on the device, and the pipes of the executors are
+ * only distinguished by the cell type, which means that the executors would share them.
+ */
+
+#define BENCH_STRINGIFY(x) #x
+#define BENCH_TO_STRING(x) BENCH_STRINGIFY(x)
+
+using BenchKernel = BENCH_KERNEL;
+using BenchExecutor =
+    BENCH_EXECUTOR<BenchKernel::Cell, BenchKernel::stencil_radius, BenchKernel,
+                   BENCH_PIPELINE_LENGTH, BENCH_TILE_WIDTH, BENCH_TILE_HEIGHT>;
+
+void bench_all(BenchOptions const &options, std::vector<BenchResult> &results) {
+    using MonotileExecutorImpl =
+        MonotileExecutor<BenchKernel::Cell, BenchKernel::stencil_radius, BenchKernel,
+                         BENCH_PIPELINE_LENGTH, BENCH_TILE_WIDTH, BENCH_TILE_HEIGHT>;
+
+    for (uindex_t grid_size : options.grid_sizes) {
+        if (std::is_same<BenchExecutor, MonotileExecutorImpl>::value &&
+            (grid_size > BENCH_TILE_WIDTH || grid_size > BENCH_TILE_HEIGHT)) {
+            std::cerr << "Skipping grid " << grid_size << "x" << grid_size
+                      << " since it does not fit into the tile" << std::endl;
+            continue;
+        }
+        print_configuration<BenchKernel, BENCH_PIPELINE_LENGTH, BENCH_TILE_WIDTH,
+                            BENCH_TILE_HEIGHT>(grid_size);
+        bench_executor<BenchExecutor, BenchKernel, BENCH_PIPELINE_LENGTH, BENCH_TILE_WIDTH,
+                       BENCH_TILE_HEIGHT>(BENCH_TO_STRING(BENCH_EXECUTOR), grid_size, options,
+                                          results);
+    }
+}
+
+#elif defined(HARDWARE)
+#error "Hardware builds have to select a single configuration, see the bench_hw target"
+#else
+
+template <typename Kernel, uindex_t pipeline_length, uindex_t tile_width, uindex_t tile_height>
+void bench_configuration(BenchOptions const &options, std::vector<BenchResult> &results) {
+    using Cell = typename Kernel::Cell;
+    constexpr uindex_t stencil_radius = Kernel::stencil_radius;
+    using TiledExecutor =
+        StencilExecutor<Cell, stencil_radius, Kernel, pipeline_length, tile_width, tile_height>;
+    using MonotileExecutorImpl =
+        MonotileExecutor<Cell, stencil_radius, Kernel, pipeline_length, tile_width, tile_height>;
+    using SkewedExecutorImpl =
+        SkewedExecutor<Cell, stencil_radius, Kernel, pipeline_length, tile_width, tile_height>;
+    using HostExecutorImpl =
+        HostExecutor<Cell, stencil_radius, Kernel, pipeline_length, tile_width, tile_height>;
+
+    for (uindex_t grid_size : options.grid_sizes) {
+        print_configuration<Kernel, pipeline_length, tile_width, tile_height>(grid_size);
+
+        bench_executor<TiledExecutor, Kernel, pipeline_length, tile_width, tile_height>(
+            "StencilExecutor", grid_size, options, results);
+        bench_executor<SkewedExecutorImpl, Kernel, pipeline_length, tile_width, tile_height>(
+            "SkewedExecutor", grid_size, options, results);
+        if (grid_size <= tile_width && grid_size <= tile_height) {
+            bench_executor<MonotileExecutorImpl, Kernel, pipeline_length, tile_width,
+                           tile_height>("MonotileExecutor", grid_size, options, results);
+        }
+        bench_executor<HostExecutorImpl, Kernel, pipeline_length, tile_width, tile_height>(
+            "HostExecutor", grid_size, options, results);
+
+        // The tiles of the bit-packed executor have as many rows of words as the other executors
+        // have rows of cells.
+        if constexpr (std::is_same<Kernel, ConwayBench>::value) {
+            using BitPackedExecutorImpl =
+                BitPackedExecutor<uint64_t, pipeline_length, tile_width, tile_height>;
+            bench_executor<BitPackedExecutorImpl, Kernel, pipeline_length, tile_width,
+                           tile_height>("BitPackedExecutor", grid_size, options, results);
+        }
+    }
+}
+
+template <typename Kernel>
+void bench_kernel(BenchOptions const &options, std::vector<BenchResult> &results) {
+    // The shortest pipeline has one stage per data path of the kernel, see stage_period.
+    constexpr uindex_t min_pipeline_length = stage_period<Kernel>::value;
+    bench_configuration<Kernel, min_pipeline_length, 256, 256>(options, results);
+    bench_configuration<Kernel, 8, 256, 256>(options, results);
+    bench_configuration<Kernel, min_pipeline_length, 1024, 1024>(options, results);
+    bench_configuration<Kernel, 8, 1024, 1024>(options, results);
+}
+
+void bench_all(BenchOptions const &options, std::vector<BenchResult> &results) {
+    bench_kernel<ConwayBench>(options, results);
+    bench_kernel<HotspotBench>(options, results);
+    bench_kernel<FDTDBench>(options, results);
+}
+
+#endif
+
+void write_csv(std::ostream &out, std::vector<BenchResult> const &results) {
+    out << "executor,kernel,pipeline_length,tile_width,tile_height,grid_width,grid_height,"
+           "n_generations,runtime,cells_per_second,generations_per_second,redundancy"
+        << std::endl;
+    for (BenchResult const &result : results) {
+        out << result.get_key() << "," << result.n_generations << "," << result.runtime << ","
+            << result.get_cells_per_second() << "," << result.get_generations_per_second() << ","
+            << result.redundancy << std::endl;
+    }
+}
+
+void write_json(std::ostream &out, std::vector<BenchResult> const &results) {
+    out << "[";
+    for (uindex_t i = 0; i < results.size(); i++) {
+        BenchResult const &result = results[i];
+        out << (i == 0 ? "" : ",") << "\n  {\"executor\": \"" << result.executor
+            << "\", \"kernel\": \"" << result.kernel
+            << "\", \"pipeline_length\": " << result.pipeline_length
+            << ", \"tile_width\": " << result.tile_width
+            << ", \"tile_height\": " << result.tile_height
+            << ", \"grid_width\": " << result.grid_width
+            << ", \"grid_height\": " << result.grid_height
+            << ", \"n_generations\": " << result.n_generations
+            << ", \"runtime\": " << result.runtime
+            << ", \"cells_per_second\": " << result.get_cells_per_second()
+            << ", \"generations_per_second\": " << result.get_generations_per_second()
+            << ", \"redundancy\": " << result.redundancy << "}";
+    }
+    out << "\n]" << std::endl;
+}
+
+/*
+ * Read the cell throughputs of a baseline that has been written by this harness in CSV format,
+ * indexed by the configuration key.
+ */
+std::map<std::string, double> read_baseline(std::string path) {
+    std::ifstream baseline_file(path);
+    if (!baseline_file.is_open()) {
+        throw std::runtime_error("Could not open the baseline file " + path);
+    }
+
+    std::map<std::string, double> baseline;
+    std::string line;
+    std::getline(baseline_file, line); // Skip the header.
+    while (std::getline(baseline_file, line)) {
+        std::vector<std::string> fields;
+        std::stringstream line_stream(line);
+        std::string field;
+        while (std::getline(line_stream, field, ',')) {
+            fields.push_back(field);
+        }
+        // Baselines without the redundancy column are accepted too.
+        if (fields.size() != 11 && fields.size() != 12) {
+            throw std::runtime_error("Malformed line in the baseline file: " + line);
+        }
+
+        std::string key = fields[0];
+        for (uindex_t i = 1; i < 7; i++) {
+            key += "," + fields[i];
+        }
+        baseline[key] = std::stod(fields[9]);
+    }
+    return baseline;
+}
+
+/*
+ * Compare the results with the baseline and report every configuration whose cell throughput is
+ * lower than the baseline by more than the tolerance. Returns the number of regressions.
+ */
+uindex_t check_regressions(std::vector<BenchResult> const &results,
+                           std::map<std::string, double> const &baseline, double tolerance) {
+    uindex_t n_regressions = 0;
+    for (BenchResult const &result : results) {
+        auto baseline_entry = baseline.find(result.get_key());
+        if (baseline_entry == baseline.end()) {
+            std::cerr << "No baseline for " << result.get_key() << std::endl;
+            continue;
+        }
+
+        double ratio = result.get_cells_per_second() / baseline_entry->second;
+        if (ratio < 1.0 - tolerance) {
+            std::cerr << "Regression: " << result.get_key() << " reached " << ratio * 100.0
+                      << "% of the baseline throughput" << std::endl;
+            n_regressions++;
+        }
+    }
+    return n_regressions;
+}
+
+void print_usage(char *program) {
+    std::cerr << "Usage: " << program << " [options]" << std::endl;
+    std::cerr << "Options:" << std::endl;
+    std::cerr << "  -s <sizes>     Comma-separated list of grid sizes (default: 256,1024)"
+              << std::endl;
+    std::cerr << "  -g <int>       Number of generations per benchmark (default: 64)" << std::endl;
+    std::cerr << "  -T <orders>    Comma-separated list of tile orders of the StencilExecutor,"
+              << std::endl;
+    std::cerr << "                 out of column-major, row-major, z-order and snake (default: all)"
+              << std::endl;
+    std::cerr << "  -f csv|json    Output format (default: csv)" << std::endl;
+    std::cerr << "  -o <path>      Output file (default: stdout)" << std::endl;
+    std::cerr << "  -b <path>      Baseline file in CSV format to compare against" << std::endl;
+    std::cerr << "  -t <float>     Tolerated relative throughput loss (default: 0.05)"
+              << std::endl;
+}
+
+int main(int argc, char **argv) {
+    BenchOptions options;
+
+    int option;
+    while ((option = getopt(argc, argv, "hs:g:T:f:o:b:t:")) != -1) {
+        switch (option) {
+        case 's': {
+            options.grid_sizes.clear();
+            std::stringstream sizes(optarg);
+            std::string size;
+            while (std::getline(sizes, size, ',')) {
+                options.grid_sizes.push_back(std::stoul(size));
+            }
+            break;
+        }
+        case 'g':
+            options.n_generations = std::stoul(optarg);
+            break;
+        case 'T': {
+            options.tile_orders.clear();
+            std::stringstream orders(optarg);
+            std::string order;
+            while (std::getline(orders, order, ',')) {
+                if (tile_orders.count(order) == 0) {
+                    std::cerr << "Unknown tile order " << order << std::endl;
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                options.tile_orders.push_back(order);
+            }
+            break;
+        }
+        case 'f':
+            options.format = optarg;
+            break;
+        case 'o':
+            options.output_path = optarg;
+            break;
+        case 'b':
+            options.baseline_path = optarg;
+            break;
+        case 't':
+            options.tolerance = std::stod(optarg);
+            break;
+        case 'h':
+        default:
+            print_usage(argv[0]);
+            return option == 'h' ? 0 : 1;
+        }
+    }
+    if (options.format != "csv" && options.format != "json") {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    std::vector<BenchResult> results;
+    bench_all(options, results);
+
+    std::ofstream output_file;
+    if (options.output_path != "") {
+        output_file.open(options.output_path);
+        if (!output_file.is_open()) {
+            std::cerr << "Could not open the output file " << options.output_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream &out = options.output_path != "" ? output_file : std::cout;
+    if (options.format == "csv") {
+        write_csv(out, results);
+    } else {
+        write_json(out, results);
+    }
+
+    if (options.baseline_path != "") {
+        uindex_t n_regressions =
+            check_regressions(results, read_baseline(options.baseline_path), options.tolerance);
+        if (n_regressions > 0) {
+            std::cerr << n_regressions << " regression(s) found" << std::endl;
+            return 2;
+        }
+    }
+
+    return 0;
+}
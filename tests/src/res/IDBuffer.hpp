@@ -0,0 +1,49 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+#include "TransFuncs.hpp"
+#include <CL/sycl.hpp>
+#include <StencilStream/GenericID.hpp>
+#include <StencilStream/Index.hpp>
+
+template <typename T> T make_id_cell(stencil::uindex_t c, stencil::uindex_t r);
+
+template <> inline stencil::ID make_id_cell<stencil::ID>(stencil::uindex_t c, stencil::uindex_t r) {
+    return stencil::ID(c, r);
+}
+
+template <> inline Cell make_id_cell<Cell>(stencil::uindex_t c, stencil::uindex_t r) {
+    return Cell{stencil::index_t(c), stencil::index_t(r), 0, CellStatus::Normal};
+}
+
+/**
+ * Create a buffer where every cell contains its own position, in generation 0 if applicable.
+ */
+template <typename T>
+cl::sycl::buffer<T, 2> make_id_buffer(stencil::uindex_t width, stencil::uindex_t height) {
+    cl::sycl::buffer<T, 2> in_buffer(cl::sycl::range<2>(width, height));
+    auto in_buffer_ac = in_buffer.template get_access<cl::sycl::access::mode::discard_write>();
+    for (stencil::uindex_t c = 0; c < width; c++) {
+        for (stencil::uindex_t r = 0; r < height; r++) {
+            in_buffer_ac[c][r] = make_id_cell<T>(c, r);
+        }
+    }
+    return in_buffer;
+}
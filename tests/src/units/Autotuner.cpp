@@ -0,0 +1,99 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/Autotuner.hpp>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+#include <sstream>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+using TransFunc = FPGATransFunc<stencil_radius>;
+using TunerImpl =
+    Autotuner<Cell, stencil_radius, TransFunc, TilingConfiguration<1, 32, 32>,
+              TilingConfiguration<2, 64, 32>, MonotileConfiguration<2, 64, 64>,
+              MonotileConfiguration<2, 256, 256>>;
+
+TEST_CASE("Autotuner::predict", "[Autotuner]") {
+    std::vector<TuningResult> results = TunerImpl::predict(UID(128, 128), 16, 300e6);
+    // The monotile configuration with a 64x64 tile does not support the grid.
+    REQUIRE(results.size() == 3);
+    for (uindex_t i = 1; i < results.size(); i++) {
+        REQUIRE(results[i - 1].runtime <= results[i].runtime);
+    }
+
+    // Tiling configurations: 16 passes over 16 tiles with (32 + 4)^2 cycles, or 8 passes over 8
+    // tiles with (64 + 8) * (32 + 8) cycles. The monotile configuration needs 8 passes with
+    // 2 * 2 * 257 + 256^2 cycles.
+    double tiling_1_runtime = 16.0 * 16 * 36 * 36 / 300e6;
+    double tiling_2_runtime = 8.0 * 8 * 72 * 40 / 300e6;
+    double monotile_runtime = 8.0 * (2 * 2 * 257 + 256 * 256) / 300e6;
+    REQUIRE(results[0].runtime == Approx(tiling_2_runtime));
+    REQUIRE(results[0].pipeline_length == 2);
+    REQUIRE(results[0].tile_width == 64);
+    REQUIRE(results[0].tile_height == 32);
+    REQUIRE(!results[0].monotile);
+    REQUIRE(results[1].runtime == Approx(tiling_1_runtime));
+    REQUIRE(results[2].runtime == Approx(monotile_runtime));
+    REQUIRE(results[2].monotile);
+
+    TuningResult best = TunerImpl::get_best(results);
+    REQUIRE(best.runtime == results[0].runtime);
+
+    // An odd number of generations requires a partial pass.
+    std::vector<TuningResult> odd_results = TunerImpl::predict(UID(128, 128), 15, 300e6);
+    REQUIRE(odd_results[0].runtime == Approx(tiling_2_runtime));
+
+    REQUIRE_THROWS_AS(TunerImpl::get_best(std::vector<TuningResult>()), std::invalid_argument);
+}
+
+TEST_CASE("Autotuner::measure", "[Autotuner]") {
+    buffer<Cell, 2> input_buffer(range<2>(64, 64));
+    {
+        auto input_ac = input_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < 64; c++) {
+            for (uindex_t r = 0; r < 64; r++) {
+                input_ac[c][r] = Cell{index_t(c), index_t(r), 0, CellStatus::Normal};
+            }
+        }
+    }
+
+    queue working_queue(INTEL::fpga_emulator_selector{});
+    std::vector<TuningResult> results =
+        TunerImpl::measure(working_queue, input_buffer, 4, Cell::halo(), TransFunc());
+    REQUIRE(results.size() == 4);
+    for (uindex_t i = 1; i < results.size(); i++) {
+        REQUIRE(results[i - 1].runtime <= results[i].runtime);
+    }
+    REQUIRE(results[0].runtime > 0.0);
+}
+
+TEST_CASE("Autotuner::write_header", "[Autotuner]") {
+    std::stringstream header;
+    TunerImpl::write_header(header, TuningResult{16, 512, 256, false, 1.0});
+    string header_str = header.str();
+    REQUIRE(header_str.find("#pragma once") != string::npos);
+    REQUIRE(header_str.find("constexpr uindex_t tuned_pipeline_length = 16;") != string::npos);
+    REQUIRE(header_str.find("constexpr uindex_t tuned_tile_width = 512;") != string::npos);
+    REQUIRE(header_str.find("constexpr uindex_t tuned_tile_height = 256;") != string::npos);
+    REQUIRE(header_str.find("constexpr bool tuned_monotile = false;") != string::npos);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/BitPackedExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <res/catch.hpp>
+#include <random>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+buffer<bool, 2> make_random_cells(uindex_t width, uindex_t height) {
+    buffer<bool, 2> cell_buffer(range<2>(width, height));
+    auto cell_ac = cell_buffer.get_access<access::mode::discard_write>();
+    mt19937 generator(42);
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            cell_ac[c][r] = generator() % 3 == 0;
+        }
+    }
+    return cell_buffer;
+}
+
+TEST_CASE("BitPackedExecutor::pack/unpack", "[BitPackedExecutor]") {
+    using Executor = BitPackedExecutor<uint32_t>;
+    uindex_t width = 5;
+    uindex_t height = 70;
+
+    buffer<bool, 2> cell_buffer = make_random_cells(width, height);
+    buffer<uint32_t, 2> word_buffer = Executor::pack(cell_buffer, true);
+    REQUIRE(word_buffer.get_range()[0] == width);
+    REQUIRE(word_buffer.get_range()[1] == 3);
+    {
+        auto word_ac = word_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < width; c++) {
+            // The last word contains 6 cells and 26 padding bits.
+            REQUIRE((word_ac[c][2] >> 6) == 0x3ffffff);
+        }
+    }
+
+    buffer<bool, 2> unpacked_buffer(range<2>(width, height));
+    Executor::unpack(word_buffer, unpacked_buffer);
+
+    auto cell_ac = cell_buffer.get_access<access::mode::read>();
+    auto unpacked_ac = unpacked_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            REQUIRE(unpacked_ac[c][r] == cell_ac[c][r]);
+        }
+    }
+
+    buffer<bool, 2> wrong_buffer(range<2>(width, height + 32));
+    REQUIRE_THROWS_AS(Executor::unpack(word_buffer, wrong_buffer), std::range_error);
+}
+
+template <typename Executor> void test_bit_packed_executor(bool halo_value) {
+    // The grid spans multiple tiles and its height is not a multiple of the word size.
+    uindex_t width = 40;
+    uindex_t height = 150;
+    uindex_t n_generations = 7;
+
+    Executor packed_executor(halo_value, LifeLikeRule::conway());
+    packed_executor.set_input(make_random_cells(width, height));
+    REQUIRE(packed_executor.get_grid_range().c == width);
+    REQUIRE(packed_executor.get_grid_range().r == height);
+    packed_executor.run(n_generations);
+    REQUIRE(packed_executor.get_i_generation() == n_generations);
+
+    StencilExecutor<bool, 1, LifeLikeRule, 1, 16, 16> reference_executor(halo_value,
+                                                                         LifeLikeRule::conway());
+    reference_executor.set_input(make_random_cells(width, height));
+    reference_executor.run(n_generations);
+
+    buffer<bool, 2> packed_buffer(range<2>(width, height));
+    packed_executor.copy_output(packed_buffer);
+    buffer<bool, 2> reference_buffer(range<2>(width, height));
+    reference_executor.copy_output(reference_buffer);
+
+    auto packed_ac = packed_buffer.get_access<access::mode::read>();
+    auto reference_ac = reference_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            REQUIRE(packed_ac[c][r] == reference_ac[c][r]);
+        }
+    }
+}
+
+TEST_CASE("BitPackedExecutor::run", "[BitPackedExecutor]") {
+    test_bit_packed_executor<BitPackedExecutor<uint64_t, 2, 16, 8>>(false);
+    test_bit_packed_executor<BitPackedExecutor<uint32_t, 3, 16, 8>>(false);
+    test_bit_packed_executor<BitPackedExecutor<uint8_t, 2, 16, 8>>(false);
+    test_bit_packed_executor<BitPackedExecutor<uint32_t, 2, 16, 8>>(true);
+}
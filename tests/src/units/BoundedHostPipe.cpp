@@ -0,0 +1,140 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/BoundedHostPipe.hpp>
+#include <StencilStream/tiling/ExecutionKernel.hpp>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+#include <thread>
+
+using namespace stencil;
+using namespace std;
+
+TEST_CASE("BoundedHostPipe (sequential)", "[BoundedHostPipe]") {
+    using MyPipe = BoundedHostPipe<class SequentialPipeID, uindex_t, 16>;
+    REQUIRE(MyPipe::empty());
+
+    for (uindex_t i = 0; i < 16; i++) {
+        REQUIRE(MyPipe::try_write(i));
+    }
+    REQUIRE(!MyPipe::try_write(16));
+
+    for (uindex_t i = 0; i < 16; i++) {
+        REQUIRE(MyPipe::read() == i);
+    }
+    uindex_t value;
+    REQUIRE(!MyPipe::try_read(value));
+    REQUIRE(MyPipe::empty());
+
+    // Wrap around the end of the ring buffer.
+    for (uindex_t i = 0; i < 40; i++) {
+        MyPipe::write(i);
+        REQUIRE(MyPipe::read() == i);
+    }
+    REQUIRE(MyPipe::empty());
+}
+
+TEST_CASE("BoundedHostPipe::close", "[BoundedHostPipe]") {
+    using MyPipe = BoundedHostPipe<class ClosedPipeID, uindex_t, 4>;
+    MyPipe::write(1);
+    REQUIRE(!MyPipe::is_closed());
+
+    // A reader that waits for a value is released when the pipe is closed.
+    bool reader_failed = false;
+    std::thread reader([&]() {
+        MyPipe::read();
+        try {
+            MyPipe::read();
+        } catch (std::runtime_error const &) {
+            reader_failed = true;
+        }
+    });
+    MyPipe::close();
+    reader.join();
+
+    REQUIRE(reader_failed);
+    REQUIRE(MyPipe::is_closed());
+    REQUIRE_THROWS_AS(MyPipe::write(2), std::runtime_error);
+
+    MyPipe::reset();
+    REQUIRE(!MyPipe::is_closed());
+    REQUIRE(MyPipe::empty());
+    MyPipe::write(3);
+    REQUIRE(MyPipe::read() == 3);
+}
+
+TEST_CASE("BoundedHostPipe (concurrent)", "[BoundedHostPipe]") {
+    using MyPipe = BoundedHostPipe<class ConcurrentPipeID, uindex_t, 4>;
+    const uindex_t n_values = 100000;
+
+    std::thread producer([=]() {
+        for (uindex_t i = 0; i < n_values; i++) {
+            MyPipe::write(i);
+        }
+    });
+
+    bool in_order = true;
+    for (uindex_t i = 0; i < n_values; i++) {
+        in_order &= MyPipe::read() == i;
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+    REQUIRE(MyPipe::empty());
+}
+
+TEST_CASE("BoundedHostPipe (concurrent tiling::ExecutionKernel)", "[BoundedHostPipe]") {
+    using TransFunc = FPGATransFunc<stencil_radius>;
+    using in_pipe = BoundedHostPipe<class ConcurrentKernelInPipeID, Cell, 8>;
+    using out_pipe = BoundedHostPipe<class ConcurrentKernelOutPipeID, Cell, 8>;
+    using TestExecutionKernel =
+        tiling::ExecutionKernel<TransFunc, Cell, stencil_radius, pipeline_length, tile_width,
+                                tile_height, in_pipe, out_pipe>;
+
+    std::thread input_thread([]() {
+        for (index_t c = -halo_radius; c < index_t(halo_radius + tile_width); c++) {
+            for (index_t r = -halo_radius; r < index_t(halo_radius + tile_height); r++) {
+                if (c >= index_t(0) && c < index_t(tile_width) && r >= index_t(0) &&
+                    r < index_t(tile_height)) {
+                    in_pipe::write(Cell{c, r, 0, CellStatus::Normal});
+                } else {
+                    in_pipe::write(Cell::halo());
+                }
+            }
+        }
+    });
+    std::thread kernel_thread(TestExecutionKernel(TransFunc(), 0, pipeline_length, 0, 0,
+                                                  tile_width, tile_height, Cell::halo()));
+
+    bool all_valid = true;
+    for (uindex_t c = 0; c < tile_width; c++) {
+        for (uindex_t r = 0; r < tile_height; r++) {
+            Cell cell = out_pipe::read();
+            all_valid &= cell.c == c && cell.r == r && cell.i_generation == pipeline_length &&
+                         cell.status == CellStatus::Normal;
+        }
+    }
+    input_thread.join();
+    kernel_thread.join();
+
+    REQUIRE(all_valid);
+    REQUIRE(in_pipe::empty());
+    REQUIRE(out_pipe::empty());
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/HostExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <res/IDBuffer.hpp>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+#include <cstring>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+using TransFunc = FPGATransFunc<stencil_radius>;
+using HostExecutorImpl =
+    HostExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>;
+using StencilExecutorImpl =
+    StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>;
+
+TEST_CASE("HostExecutor::run", "[HostExecutor]") {
+    uindex_t n_generations = 2 * pipeline_length + 1;
+
+    HostExecutorImpl executor(Cell::halo(), TransFunc());
+    executor.set_input(make_id_buffer<Cell>(grid_width, grid_height));
+    REQUIRE(executor.get_grid_range().c == grid_width);
+    REQUIRE(executor.get_grid_range().r == grid_height);
+
+    executor.run(n_generations);
+    REQUIRE(executor.get_i_generation() == n_generations);
+
+    buffer<Cell, 2> out_buffer(range<2>(grid_width, grid_height));
+    executor.copy_output(out_buffer);
+    {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                REQUIRE(out_buffer_ac[c][r].c == c);
+                REQUIRE(out_buffer_ac[c][r].r == r);
+                REQUIRE(out_buffer_ac[c][r].i_generation == n_generations);
+                REQUIRE(out_buffer_ac[c][r].status == CellStatus::Normal);
+            }
+        }
+    }
+
+    // A second run to show that behavior is still correct when i_generation != 0:
+    executor.run(n_generations);
+    REQUIRE(executor.get_i_generation() == 2 * n_generations);
+
+    executor.copy_output(out_buffer);
+    {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                REQUIRE(out_buffer_ac[c][r].i_generation == 2 * n_generations);
+                REQUIRE(out_buffer_ac[c][r].status == CellStatus::Normal);
+            }
+        }
+    }
+}
+
+static_assert(HostExecutorImpl::burst_length == 1024 / sizeof(Cell));
+
+// Executors of different types must not share their pipes, even if the cell type and the pipe
+// capacity are the same.
+static_assert(!std::is_same<HostExecutorImpl::in_pipe,
+                            HostExecutor<Cell, stencil_radius, TransFunc, 1, tile_width,
+                                         tile_height>::in_pipe>::value);
+static_assert(!std::is_same<HostExecutorImpl::out_pipe,
+                            HostExecutor<Cell, stencil_radius, TransFunc, 1, tile_width,
+                                         tile_height>::out_pipe>::value);
+
+TEST_CASE("HostExecutor is bit-identical to StencilExecutor", "[HostExecutor]") {
+    // The grid range is not a multiple of the tile range to cover partial tiles.
+    uindex_t width = grid_width - tile_width / 2 + 3;
+    uindex_t height = grid_height - tile_height / 2 + 5;
+    uindex_t n_generations = 3 * pipeline_length - 1;
+
+    HostExecutorImpl host_executor(Cell::halo(), TransFunc());
+    host_executor.set_input(make_id_buffer<Cell>(width, height));
+    host_executor.set_i_generation(7);
+    host_executor.run(n_generations);
+
+    StencilExecutorImpl stencil_executor(Cell::halo(), TransFunc());
+    stencil_executor.set_input(make_id_buffer<Cell>(width, height));
+    stencil_executor.set_i_generation(7);
+    stencil_executor.run(n_generations);
+
+    buffer<Cell, 2> host_buffer(range<2>(width, height));
+    host_executor.copy_output(host_buffer);
+    buffer<Cell, 2> stencil_buffer(range<2>(width, height));
+    stencil_executor.copy_output(stencil_buffer);
+
+    auto host_ac = host_buffer.get_access<access::mode::read>();
+    auto stencil_ac = stencil_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            REQUIRE(memcmp(&host_ac[c][r], &stencil_ac[c][r], sizeof(Cell)) == 0);
+        }
+    }
+}
+
+struct FailingTransFunc {
+    bool fail;
+
+    float operator()(Stencil<float, 1> const &stencil) const {
+        if (fail && stencil.generation == 1 && stencil.id.c == 40 && stencil.id.r == 20) {
+            throw std::runtime_error("Failing transition function");
+        }
+        return stencil[ID(0, 0)] + 1.0f;
+    }
+};
+
+TEST_CASE("HostExecutor forwards kernel exceptions", "[HostExecutor]") {
+    using Executor = HostExecutor<float, 1, FailingTransFunc, 2, tile_width, tile_height>;
+
+    buffer<float, 2> in_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                in_buffer_ac[c][r] = 0.0f;
+            }
+        }
+    }
+
+    // The execution kernel fails while the input and output kernels wait for it. The exception has
+    // to reach the calling thread instead of terminating the process.
+    Executor executor(0.0f, FailingTransFunc{true});
+    executor.set_input(in_buffer);
+    REQUIRE_THROWS_AS(executor.run(2), std::runtime_error);
+    REQUIRE(executor.get_i_generation() == 0);
+
+    // The pipes are usable again after the failure.
+    executor.set_trans_func(FailingTransFunc{false});
+    executor.set_input(in_buffer);
+    executor.run(2);
+
+    buffer<float, 2> out_buffer(range<2>(grid_width, grid_height));
+    executor.copy_output(out_buffer);
+    auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < grid_width; c++) {
+        for (uindex_t r = 0; r < grid_height; r++) {
+            REQUIRE(out_buffer_ac[c][r] == 2.0f);
+        }
+    }
+}
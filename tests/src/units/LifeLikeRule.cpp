@@ -0,0 +1,76 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/LifeLikeRule.hpp>
+#include <res/catch.hpp>
+
+using namespace std;
+using namespace stencil;
+
+TEST_CASE("LifeLikeRule::operator()", "[LifeLikeRule]") {
+    LifeLikeRule rule = LifeLikeRule::conway();
+    REQUIRE(rule.get_birth_mask() == 0b1000);
+    REQUIRE(rule.get_survival_mask() == 0b1100);
+
+    for (uindex_t n_alive_neighbors = 0; n_alive_neighbors <= 8; n_alive_neighbors++) {
+        for (bool alive : {false, true}) {
+            Stencil<bool, 1> stencil(ID(0, 0), 0, 0, UID(3, 3));
+            uindex_t i_neighbor = 0;
+            for (index_t c = -1; c <= 1; c++) {
+                for (index_t r = -1; r <= 1; r++) {
+                    if (c == 0 && r == 0) {
+                        stencil[ID(c, r)] = alive;
+                    } else {
+                        stencil[ID(c, r)] = i_neighbor < n_alive_neighbors;
+                        i_neighbor++;
+                    }
+                }
+            }
+
+            bool expected = n_alive_neighbors == 3 || (alive && n_alive_neighbors == 2);
+            REQUIRE(rule(stencil) == expected);
+        }
+    }
+}
+
+TEST_CASE("LifeLikeRule::apply", "[LifeLikeRule]") {
+    // B36/S23, also known as HighLife.
+    LifeLikeRule rule((1 << 3) | (1 << 6), (1 << 2) | (1 << 3));
+
+    // Bit i of the words is a cell with i % 9 alive neighbors that is alive if i >= 32.
+    uint64_t alive = 0xffffffff00000000;
+    uint64_t neighbors[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    for (uindex_t i = 0; i < 64; i++) {
+        for (uindex_t i_neighbor = 0; i_neighbor < i % 9; i_neighbor++) {
+            neighbors[i_neighbor] |= uint64_t(1) << i;
+        }
+    }
+
+    uint64_t new_alive = rule.apply(alive, neighbors);
+    for (uindex_t i = 0; i < 64; i++) {
+        uindex_t n_alive_neighbors = i % 9;
+        bool expected;
+        if (i >= 32) {
+            expected = n_alive_neighbors == 2 || n_alive_neighbors == 3;
+        } else {
+            expected = n_alive_neighbors == 3 || n_alive_neighbors == 6;
+        }
+        REQUIRE(((new_alive >> i) & 0b1) == expected);
+    }
+}
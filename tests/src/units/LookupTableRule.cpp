@@ -0,0 +1,108 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/LifeLikeRule.hpp>
+#include <StencilStream/LookupTableRule.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+#include <random>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+TEST_CASE("LookupTableRule::parse", "[LookupTableRule]") {
+    using Rule = LookupTableRule<uint8_t, 3>;
+
+    Rule conway = Rule::parse("B3/S23");
+    for (uindex_t n = 0; n <= Rule::n_neighbors; n++) {
+        REQUIRE(conway.get_transition(0, n) == (n == 3 ? 1 : 0));
+        REQUIRE(conway.get_transition(1, n) == (n == 2 || n == 3 ? 1 : 0));
+    }
+
+    Rule brians_brain = Rule::parse("b2/s/c3");
+    for (uindex_t n = 0; n <= Rule::n_neighbors; n++) {
+        REQUIRE(brians_brain.get_transition(0, n) == (n == 2 ? 1 : 0));
+        REQUIRE(brians_brain.get_transition(1, n) == 2);
+        REQUIRE(brians_brain.get_transition(2, n) == 0);
+    }
+
+    REQUIRE_THROWS_AS(Rule::parse("B3"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Rule::parse("S23/B3"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Rule::parse("B39/S23"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Rule::parse("B3/S23/C"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Rule::parse("B3/S23/C4"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Rule::parse("B3/S23/C99999999999999999999999"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Rule::parse("B3/S23/"), std::invalid_argument);
+    REQUIRE_THROWS_AS(Rule::parse("B3/"), std::invalid_argument);
+
+    REQUIRE_THROWS_AS(conway.get_transition(3, 0), std::out_of_range);
+    REQUIRE_THROWS_AS(conway.get_transition(0, 9), std::out_of_range);
+    REQUIRE_THROWS_AS(conway.set_transition(0, 0, 3), std::out_of_range);
+}
+
+TEST_CASE("LookupTableExecutor::run", "[LookupTableRule]") {
+    using Rule = LookupTableRule<uint8_t, 2>;
+    using Executor = LookupTableExecutor<uint8_t, 2, pipeline_length, tile_width, tile_height>;
+    using ReferenceExecutor =
+        StencilExecutor<bool, 1, LifeLikeRule, pipeline_length, tile_width, tile_height>;
+    uindex_t n_generations = 5;
+
+    buffer<uint8_t, 2> in_buffer(range<2>(grid_width, grid_height));
+    buffer<bool, 2> reference_in_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_ac = in_buffer.get_access<access::mode::discard_write>();
+        auto reference_in_ac = reference_in_buffer.get_access<access::mode::discard_write>();
+        mt19937 generator(42);
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                bool alive = generator() % 3 == 0;
+                in_ac[c][r] = alive;
+                reference_in_ac[c][r] = alive;
+            }
+        }
+    }
+
+    // The rule is switched at runtime, without a different executor type.
+    for (std::string rule_string : {"B3/S23", "B36/S23"}) {
+        uint16_t birth_mask = rule_string == "B3/S23" ? 0b1000 : 0b1001000;
+
+        Executor executor(0, Rule());
+        executor.set_trans_func(Rule::parse(rule_string));
+        executor.set_input(in_buffer);
+        executor.run(n_generations);
+
+        ReferenceExecutor reference_executor(false, LifeLikeRule(birth_mask, 0b1100));
+        reference_executor.set_input(reference_in_buffer);
+        reference_executor.run(n_generations);
+
+        buffer<uint8_t, 2> out_buffer(range<2>(grid_width, grid_height));
+        executor.copy_output(out_buffer);
+        buffer<bool, 2> reference_out_buffer(range<2>(grid_width, grid_height));
+        reference_executor.copy_output(reference_out_buffer);
+
+        auto out_ac = out_buffer.get_access<access::mode::read>();
+        auto reference_out_ac = reference_out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                REQUIRE(out_ac[c][r] == reference_out_ac[c][r]);
+            }
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/MonotileBatchExecutor.hpp>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+using TransFunc = FPGATransFunc<stencil_radius>;
+using MonotileBatchExecutorImpl =
+    MonotileBatchExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width,
+                          tile_height>;
+
+TEST_CASE("MonotileBatchExecutor::run", "[MonotileBatchExecutor]") {
+    uindex_t n_grids = 3;
+    uindex_t n_generations = 2 * pipeline_length + 1;
+    uindex_t batch_grid_width = tile_width - 1;
+    uindex_t batch_grid_height = tile_height - 1;
+
+    vector<buffer<Cell, 2>> in_buffers;
+    for (uindex_t i_grid = 0; i_grid < n_grids; i_grid++) {
+        buffer<Cell, 2> in_buffer(range<2>(batch_grid_width, batch_grid_height));
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < batch_grid_width; c++) {
+            for (uindex_t r = 0; r < batch_grid_height; r++) {
+                in_buffer_ac[c][r] = Cell{index_t(c), index_t(r), 0, CellStatus::Normal};
+            }
+        }
+        in_buffers.push_back(in_buffer);
+    }
+
+    MonotileBatchExecutorImpl executor(Cell::halo(), TransFunc());
+    executor.set_inputs(in_buffers);
+    REQUIRE(executor.get_batch_size() == n_grids);
+    REQUIRE(executor.get_grid_range().c == batch_grid_width);
+    REQUIRE(executor.get_grid_range().r == batch_grid_height);
+
+    executor.run(n_generations);
+    REQUIRE(executor.get_i_generation() == n_generations);
+
+    vector<buffer<Cell, 2>> out_buffers;
+    for (uindex_t i_grid = 0; i_grid < n_grids; i_grid++) {
+        out_buffers.push_back(buffer<Cell, 2>(range<2>(batch_grid_width, batch_grid_height)));
+    }
+    executor.copy_outputs(out_buffers);
+
+    for (buffer<Cell, 2> out_buffer : out_buffers) {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < batch_grid_width; c++) {
+            for (uindex_t r = 0; r < batch_grid_height; r++) {
+                REQUIRE(out_buffer_ac[c][r].c == c);
+                REQUIRE(out_buffer_ac[c][r].r == r);
+                REQUIRE(out_buffer_ac[c][r].i_generation == n_generations);
+                REQUIRE(out_buffer_ac[c][r].status == CellStatus::Normal);
+            }
+        }
+    }
+
+    REQUIRE_THROWS_AS(executor.copy_output(out_buffers[0]), std::logic_error);
+}
+
+TEST_CASE("MonotileBatchExecutor: Grids are separated", "[MonotileBatchExecutor]") {
+    auto trans_func = [](Stencil<uint8_t, 1> const &stencil) {
+        uint8_t max = 0;
+        for (index_t c = -1; c <= 1; c++) {
+            for (index_t r = -1; r <= 1; r++) {
+                max = std::max(max, stencil[ID(c, r)]);
+            }
+        }
+        return max;
+    };
+    using Executor = MonotileBatchExecutor<uint8_t, 1, decltype(trans_func), 4, 16, 16>;
+
+    vector<buffer<uint8_t, 2>> buffers;
+    for (uint8_t i_grid = 0; i_grid < 4; i_grid++) {
+        buffer<uint8_t, 2> grid_buffer(range<2>(16, 16));
+        auto ac = grid_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < 16; c++) {
+            for (uindex_t r = 0; r < 16; r++) {
+                ac[c][r] = i_grid % 2 == 0 ? 2 * i_grid : 1;
+            }
+        }
+        buffers.push_back(grid_buffer);
+    }
+
+    Executor executor(0, trans_func);
+    executor.set_inputs(buffers);
+    executor.run(6);
+    executor.copy_outputs(buffers);
+
+    for (uint8_t i_grid = 0; i_grid < 4; i_grid++) {
+        auto ac = buffers[i_grid].get_access<access::mode::read>();
+        for (uindex_t c = 0; c < 16; c++) {
+            for (uindex_t r = 0; r < 16; r++) {
+                REQUIRE(ac[c][r] == (i_grid % 2 == 0 ? 2 * i_grid : 1));
+            }
+        }
+    }
+}
+
+TEST_CASE("MonotileBatchExecutor::set_inputs", "[MonotileBatchExecutor]") {
+    MonotileBatchExecutorImpl executor(Cell::halo(), TransFunc());
+
+    REQUIRE_THROWS_AS(executor.set_inputs({}), std::invalid_argument);
+
+    buffer<Cell, 2> small_buffer(range<2>(tile_width, tile_height));
+    buffer<Cell, 2> other_buffer(range<2>(tile_width - 1, tile_height));
+    REQUIRE_THROWS_AS(executor.set_inputs({small_buffer, other_buffer}), std::invalid_argument);
+
+    buffer<Cell, 2> big_buffer(range<2>(tile_width + 1, tile_height));
+    REQUIRE_THROWS_AS(executor.set_inputs({big_buffer}), std::range_error);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/MonotileExecutor.hpp>
+#include <StencilStream/PerformanceModel.hpp>
+#include <StencilStream/SkewedExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace std;
+using namespace stencil;
+
+using TransFunc = FPGATransFunc<stencil_radius>;
+using TilingModel =
+    TilingPerformanceModel<Cell, stencil_radius, pipeline_length, tile_width, tile_height>;
+using MonotileModel =
+    MonotilePerformanceModel<Cell, stencil_radius, pipeline_length, tile_width, tile_height>;
+using SkewedModel =
+    SkewedPerformanceModel<Cell, stencil_radius, pipeline_length, tile_width, tile_height>;
+
+static_assert(TilingModel::n_cycles_per_tile ==
+              tiling::ExecutionKernel<TransFunc, Cell, stencil_radius, pipeline_length, tile_width,
+                                      tile_height, void, void>::n_input_cells);
+static_assert(MonotileModel::n_cycles_per_tile ==
+              monotile::ExecutionKernel<TransFunc, Cell, stencil_radius, pipeline_length,
+                                        tile_width, tile_height, void, void>::n_iterations);
+static_assert(std::is_same<StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length,
+                                           tile_width, tile_height>::PerformanceModel,
+                           TilingModel>::value);
+static_assert(std::is_same<MonotileExecutor<Cell, stencil_radius, TransFunc, pipeline_length,
+                                            tile_width, tile_height>::PerformanceModel,
+                           MonotileModel>::value);
+static_assert(std::is_same<SkewedExecutor<Cell, stencil_radius, TransFunc, pipeline_length,
+                                          tile_width, tile_height>::PerformanceModel,
+                           SkewedModel>::value);
+
+TEST_CASE("TilingPerformanceModel::predict_pass", "[PerformanceModel]") {
+    constexpr PassPrediction prediction = TilingModel::predict_pass(grid_width + 1, grid_height);
+    constexpr uint64_t n_tiles = (grid_width / tile_width + 1) * (grid_height / tile_height);
+    constexpr uint64_t n_input_cells =
+        (tile_width + 2 * halo_radius) * (tile_height + 2 * halo_radius);
+
+    REQUIRE(prediction.n_kernel_invocations == n_tiles);
+    REQUIRE(prediction.n_cycles == n_tiles * n_input_cells);
+    REQUIRE(prediction.n_cell_updates == (grid_width + 1) * grid_height * pipeline_length);
+    REQUIRE(prediction.n_computed_cell_updates == n_tiles * n_input_cells * pipeline_length);
+    REQUIRE(prediction.n_bytes_read == n_tiles * n_input_cells * sizeof(Cell));
+    REQUIRE(prediction.n_bytes_written == n_tiles * tile_width * tile_height * sizeof(Cell));
+    REQUIRE(prediction.get_redundancy() > 0.0);
+    REQUIRE(prediction.get_redundancy() < 1.0);
+    REQUIRE(prediction.get_runtime(1e6) == double(n_tiles * n_input_cells) / 1e6);
+
+    PassPrediction partial_prediction = TilingModel::predict_pass(grid_width, grid_height, 1);
+    REQUIRE(partial_prediction.n_cell_updates == grid_width * grid_height);
+    REQUIRE(partial_prediction.n_cycles ==
+            TilingModel::predict_pass(grid_width, grid_height).n_cycles);
+}
+
+TEST_CASE("MonotilePerformanceModel::predict_pass", "[PerformanceModel]") {
+    constexpr uint64_t n_cells = tile_width * tile_height;
+    constexpr uint64_t latency = pipeline_length * stencil_radius * (tile_height + 1);
+
+    PassPrediction prediction = MonotileModel::predict_pass(tile_width / 2, tile_height);
+    REQUIRE(prediction.n_kernel_invocations == 1);
+    REQUIRE(prediction.n_cycles == latency + n_cells);
+    REQUIRE(prediction.n_cell_updates == n_cells / 2 * pipeline_length);
+    REQUIRE(prediction.n_computed_cell_updates == n_cells * pipeline_length);
+    REQUIRE(prediction.get_redundancy() == 0.5);
+    REQUIRE(prediction.n_bytes_read == n_cells / 2 * sizeof(Cell));
+    REQUIRE(prediction.n_bytes_written == n_cells / 2 * sizeof(Cell));
+
+    PassPrediction batch_prediction = MonotileModel::predict_pass(tile_width, tile_height,
+                                                                  pipeline_length, 4);
+    REQUIRE(batch_prediction.n_cycles == latency + 4 * n_cells);
+    REQUIRE(batch_prediction.get_redundancy() == 0.0);
+}
+
+TEST_CASE("SkewedPerformanceModel::predict_pass", "[PerformanceModel]") {
+    constexpr uint64_t skew = pipeline_length * stencil_radius;
+    constexpr uint64_t n_tile_columns = (grid_width + skew) / tile_width + 1;
+    constexpr uint64_t n_tile_rows = (grid_height + skew) / tile_height + 1;
+    constexpr uint64_t n_cycles = (grid_width + skew + n_tile_columns * 2 * stencil_radius) *
+                                  (grid_height + skew + n_tile_rows * 2 * stencil_radius);
+    constexpr uint64_t n_strip_cells = n_cycles - (grid_width + skew) * (grid_height + skew);
+    constexpr uint64_t strip_size = (pipeline_length - 1) * sizeof(Cell);
+
+    PassPrediction prediction = SkewedModel::predict_pass(grid_width, grid_height);
+    REQUIRE(SkewedModel::get_n_tile_columns(grid_width) == n_tile_columns);
+    REQUIRE(SkewedModel::get_n_tile_rows(grid_height) == n_tile_rows);
+    REQUIRE(prediction.n_kernel_invocations == n_tile_columns * n_tile_rows);
+    REQUIRE(prediction.n_cycles == n_cycles);
+    REQUIRE(prediction.n_cell_updates == grid_width * grid_height * pipeline_length);
+    REQUIRE(prediction.n_computed_cell_updates == n_cycles * pipeline_length);
+    REQUIRE(prediction.n_bytes_read == n_cycles * sizeof(Cell) + n_strip_cells * strip_size);
+    REQUIRE(prediction.n_bytes_written ==
+            grid_width * grid_height * sizeof(Cell) + n_strip_cells * strip_size);
+
+    PassPrediction partial_prediction = SkewedModel::predict_pass(grid_width, grid_height, 1);
+    REQUIRE(partial_prediction.n_cell_updates == grid_width * grid_height);
+    REQUIRE(partial_prediction.n_cycles == n_cycles);
+}
+
+TEST_CASE("SkewedPerformanceModel has less redundancy than TilingPerformanceModel",
+          "[PerformanceModel]") {
+    // The tile range and pipeline length of the FDTD example.
+    using FDTDTilingModel = TilingPerformanceModel<float, 1, 16, 512, 512>;
+    using FDTDSkewedModel = SkewedPerformanceModel<float, 1, 16, 512, 512>;
+
+    for (uindex_t grid_size : {512, 1024, 4096}) {
+        PassPrediction tiling_prediction = FDTDTilingModel::predict_pass(grid_size, grid_size);
+        PassPrediction skewed_prediction = FDTDSkewedModel::predict_pass(grid_size, grid_size);
+        REQUIRE(skewed_prediction.n_cell_updates == tiling_prediction.n_cell_updates);
+        REQUIRE(skewed_prediction.get_redundancy() < tiling_prediction.get_redundancy());
+    }
+
+    REQUIRE(FDTDTilingModel::predict_pass(4096, 4096).get_redundancy() > 0.1);
+    REQUIRE(FDTDSkewedModel::predict_pass(4096, 4096).get_redundancy() < 0.02);
+}
+
+TEST_CASE("PassPrediction::compare", "[PerformanceModel]") {
+    PassPrediction prediction{1, 1000, 1000, 1000, 4000, 4000};
+
+    RuntimeSample sample;
+    sample.add_pass(2e-3);
+    sample.add_pass(2e-3);
+
+    PerformanceComparison comparison = prediction.compare(sample, 1e6);
+    REQUIRE(comparison.predicted_pass_runtime == Approx(1e-3));
+    REQUIRE(comparison.measured_pass_runtime == Approx(2e-3));
+    REQUIRE(comparison.efficiency == Approx(0.5));
+    REQUIRE(comparison.predicted_bandwidth == Approx(8000 / 1e-3 / 1e9));
+    REQUIRE(comparison.measured_bandwidth == Approx(8000 / 2e-3 / 1e9));
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/Reduction.hpp>
+#include <res/catch.hpp>
+
+using namespace stencil;
+
+TEST_CASE("MaxAbsDifference", "[Reduction]") {
+    MaxAbsDifference<float> reduction;
+    REQUIRE(reduction.identity() == 0.0f);
+    REQUIRE(reduction.map(1.0f, 3.5f) == 2.5f);
+    REQUIRE(reduction.map(3.5f, 1.0f) == 2.5f);
+    REQUIRE(reduction.map(-1.0f, -1.0f) == 0.0f);
+    REQUIRE(reduction.combine(2.0f, 3.0f) == 3.0f);
+    REQUIRE(reduction.combine(3.0f, 2.0f) == 3.0f);
+    REQUIRE(reduction.combine(reduction.identity(), 0.5f) == 0.5f);
+
+    MaxAbsDifference<int> int_reduction;
+    REQUIRE(int_reduction.map(-3, 4) == 7);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/PerformanceModel.hpp>
+#include <StencilStream/ResourceEstimate.hpp>
+#include <StencilStream/monotile/ExecutionKernel.hpp>
+#include <StencilStream/tiling/ExecutionKernel.hpp>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace std;
+using namespace stencil;
+
+using TransFunc = FPGATransFunc<stencil_radius>;
+using TilingKernel = tiling::ExecutionKernel<TransFunc, Cell, stencil_radius, pipeline_length,
+                                             tile_width, tile_height, void, void>;
+using MonotileKernel = monotile::ExecutionKernel<TransFunc, Cell, stencil_radius, pipeline_length,
+                                                 tile_width, tile_height, void, void>;
+
+// The budget checks are usable at compile time.
+static_assert(TilingKernel::resource_estimate.fits(ResourceBudget{1000, 1000000}));
+static_assert(!TilingKernel::resource_estimate.fits(ResourceBudget{1, 1000000}));
+static_assert(!MonotileKernel::resource_estimate.fits(ResourceBudget{1000, 1}));
+
+TEST_CASE("ResourceEstimate::estimate", "[ResourceEstimate]") {
+    constexpr uint64_t cell_bits = 8 * sizeof(Cell);
+    constexpr uint64_t stencil_diameter = 2 * stencil_radius + 1;
+    constexpr uint64_t bank_width = (stencil_diameter - 1) * cell_bits;
+    constexpr uint64_t cache_height = tile_height + 2 * halo_radius;
+
+    constexpr ResourceEstimate estimate = TilingKernel::resource_estimate;
+    REQUIRE(estimate.n_cache_bits == 2 * cache_height * pipeline_length * bank_width);
+    REQUIRE(estimate.n_used_cache_bits == estimate.n_cache_bits);
+    REQUIRE(estimate.n_cache_banks == 2 * pipeline_length);
+    REQUIRE(estimate.n_wasted_cache_banks == 0);
+    REQUIRE(estimate.n_memory_blocks == 2 * pipeline_length * ((bank_width + 39) / 40));
+    REQUIRE(estimate.n_register_bits_per_stage == stencil_diameter * stencil_diameter * cell_bits);
+    REQUIRE(estimate.n_register_bits == pipeline_length * estimate.n_register_bits_per_stage);
+
+    // A pipeline length of 3 is padded to 4 stage slots.
+    constexpr ResourceEstimate padded_estimate =
+        ResourceEstimate::estimate<Cell, stencil_radius, 3>(1024);
+    REQUIRE(padded_estimate.n_cache_banks == 8);
+    REQUIRE(padded_estimate.n_wasted_cache_banks == 2);
+    REQUIRE(padded_estimate.n_cache_bits == 2 * 1024 * 4 * bank_width);
+    REQUIRE(padded_estimate.n_used_cache_bits == 2 * 1024 * 3 * bank_width);
+    REQUIRE(padded_estimate.n_memory_blocks == 2 * 3 * ((bank_width + 39) / 40) * 2);
+}
+
+TEST_CASE("ResourceEstimate of the monotile kernel", "[ResourceEstimate]") {
+    constexpr ResourceEstimate estimate = MonotileKernel::resource_estimate;
+    constexpr uint64_t stencil_diameter = 2 * stencil_radius + 1;
+    REQUIRE(estimate.n_cache_bits ==
+            2 * tile_height * pipeline_length * (stencil_diameter - 1) * 8 * sizeof(Cell));
+    REQUIRE(estimate.n_register_bits_per_stage ==
+            stencil_diameter * stencil_diameter * 8 * sizeof(Cell) +
+                MonotileKernel::n_counter_bits_per_stage);
+}
+
+TEST_CASE("ResourceEstimate of the performance models", "[ResourceEstimate]") {
+    using TilingModel =
+        TilingPerformanceModel<Cell, stencil_radius, pipeline_length, tile_width, tile_height>;
+    using MonotileModel =
+        MonotilePerformanceModel<Cell, stencil_radius, pipeline_length, tile_width, tile_height>;
+
+    REQUIRE(TilingModel::resource_estimate.n_cache_bits ==
+            TilingKernel::resource_estimate.n_cache_bits);
+    REQUIRE(TilingModel::resource_estimate.n_register_bits ==
+            TilingKernel::resource_estimate.n_register_bits);
+    REQUIRE(MonotileModel::resource_estimate.n_cache_bits ==
+            MonotileKernel::resource_estimate.n_cache_bits);
+    REQUIRE(MonotileModel::resource_estimate.n_register_bits ==
+            MonotileKernel::resource_estimate.n_register_bits);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/MonotileExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <fstream>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+#include <sstream>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+using TransFunc = FPGATransFunc<stencil_radius>;
+using KernelCategory = RuntimeSample::KernelCategory;
+
+TEST_CASE("RuntimeSample::add_pass", "[RuntimeSample]") {
+    RuntimeSample sample;
+    REQUIRE(sample.get_n_passes() == 0);
+    REQUIRE(sample.get_n_kernels(KernelCategory::INPUT) == 0);
+    REQUIRE(sample.get_kernel_runtime_percentile(KernelCategory::INPUT, 0.5) == 0.0);
+    REQUIRE_THROWS_AS(sample.get_kernel_runtime_percentile(KernelCategory::INPUT, -0.1),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(sample.get_kernel_runtime_percentile(KernelCategory::INPUT, 1.1),
+                      std::invalid_argument);
+
+    sample.add_pass(1.0, 100.0);
+    sample.add_pass(3.0, 100.0);
+    REQUIRE(sample.get_n_passes() == 2);
+    REQUIRE(sample.get_total_runtime() == 4.0);
+    REQUIRE(sample.get_mean_speed() == 0.5);
+    REQUIRE(sample.get_cell_throughput() == 50.0);
+}
+
+TEST_CASE("RuntimeSample: Kernel records of the StencilExecutor", "[RuntimeSample]") {
+    StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>
+        executor(Cell::halo(), TransFunc());
+    executor.select_emulator(true);
+    executor.set_input(buffer<Cell, 2>(range<2>(grid_width, grid_height)));
+    executor.run(2 * pipeline_length);
+
+    uindex_t n_tiles = (grid_width / tile_width) * (grid_height / tile_height);
+    RuntimeSample &sample = executor.get_runtime_sample();
+    REQUIRE(sample.get_n_passes() == 2);
+    REQUIRE(sample.get_n_kernels(KernelCategory::INPUT) == 2 * 5 * n_tiles);
+    REQUIRE(sample.get_n_kernels(KernelCategory::EXECUTION) == 2 * n_tiles);
+    REQUIRE(sample.get_n_kernels(KernelCategory::OUTPUT) == 2 * 3 * n_tiles);
+
+    double n_cells = grid_width * grid_height;
+    REQUIRE(sample.get_n_bytes(KernelCategory::OUTPUT) == 2 * n_cells * sizeof(Cell));
+    REQUIRE(sample.get_n_bytes(KernelCategory::INPUT) > 2 * n_cells * sizeof(Cell));
+
+    std::vector<RuntimeSample::KernelRecord> records = sample.get_kernel_records();
+    REQUIRE(records.size() == 2 * 9 * n_tiles);
+    for (RuntimeSample::KernelRecord const &record : records) {
+        REQUIRE(record.i_pass < 2);
+        REQUIRE(record.tile_id.c < grid_width / tile_width);
+        REQUIRE(record.tile_id.r < grid_height / tile_height);
+        REQUIRE(record.start <= record.end);
+    }
+
+    for (KernelCategory category :
+         {KernelCategory::INPUT, KernelCategory::EXECUTION, KernelCategory::OUTPUT}) {
+        double min = sample.get_kernel_runtime_percentile(category, 0.0);
+        double median = sample.get_kernel_runtime_percentile(category, 0.5);
+        double max = sample.get_kernel_runtime_percentile(category, 1.0);
+        REQUIRE(min <= median);
+        REQUIRE(median <= max);
+        REQUIRE(sample.get_total_kernel_runtime(category) >= max);
+    }
+}
+
+TEST_CASE("RuntimeSample: Kernel records of the MonotileExecutor", "[RuntimeSample]") {
+    MonotileExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>
+        executor(Cell::halo(), TransFunc());
+    executor.select_emulator(true);
+    executor.set_input(buffer<Cell, 2>(range<2>(tile_width, tile_height)));
+    executor.run(3 * pipeline_length);
+
+    RuntimeSample &sample = executor.get_runtime_sample();
+    REQUIRE(sample.get_n_passes() == 3);
+    REQUIRE(sample.get_n_kernels(KernelCategory::INPUT) == 3);
+    REQUIRE(sample.get_n_kernels(KernelCategory::EXECUTION) == 3);
+    REQUIRE(sample.get_n_kernels(KernelCategory::OUTPUT) == 3);
+    REQUIRE(sample.get_cell_throughput() > 0.0);
+}
+
+TEST_CASE("RuntimeSample::clear", "[RuntimeSample]") {
+    MonotileExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>
+        executor(Cell::halo(), TransFunc());
+    executor.select_emulator(true);
+    executor.set_input(buffer<Cell, 2>(range<2>(tile_width, tile_height)));
+    executor.run(2 * pipeline_length);
+
+    RuntimeSample &sample = executor.get_runtime_sample();
+    REQUIRE(sample.get_n_passes() == 2);
+    sample.clear();
+    REQUIRE(sample.get_n_passes() == 0);
+    REQUIRE(sample.get_total_runtime() == 0.0);
+    REQUIRE(sample.get_kernel_records().size() == 0);
+
+    executor.run(pipeline_length);
+    REQUIRE(sample.get_n_passes() == 1);
+    REQUIRE(sample.get_n_kernels(KernelCategory::EXECUTION) == 1);
+    for (RuntimeSample::KernelRecord const &record : sample.get_kernel_records()) {
+        REQUIRE(record.i_pass == 0);
+    }
+}
+
+uindex_t count_occurrences(string const &haystack, string const &needle) {
+    uindex_t n_occurrences = 0;
+    for (size_t pos = haystack.find(needle); pos != string::npos;
+         pos = haystack.find(needle, pos + needle.size())) {
+        n_occurrences++;
+    }
+    return n_occurrences;
+}
+
+TEST_CASE("RuntimeSample::write_chrome_trace", "[RuntimeSample]") {
+    StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>
+        executor(Cell::halo(), TransFunc());
+    executor.select_emulator(true);
+    executor.set_input(buffer<Cell, 2>(range<2>(grid_width, grid_height)));
+    executor.run(2 * pipeline_length);
+
+    std::stringstream trace;
+    executor.get_runtime_sample().write_chrome_trace(trace);
+    string trace_str = trace.str();
+
+    uindex_t n_tiles = (grid_width / tile_width) * (grid_height / tile_height);
+    REQUIRE(trace_str.front() == '{');
+    REQUIRE(count_occurrences(trace_str, "\"ph\":\"X\"") == 2 * 9 * n_tiles);
+    REQUIRE(count_occurrences(trace_str, "\"thread_name\"") == 9);
+    REQUIRE(count_occurrences(trace_str, "\"name\":\"input 4\"") == 1);
+    REQUIRE(count_occurrences(trace_str, "\"name\":\"execution 0\"") == 1);
+    REQUIRE(count_occurrences(trace_str, "\"name\":\"output 2\"") == 1);
+
+    string path = "/tmp/stencil_runtime_sample_trace.json";
+    executor.write_trace(path);
+    std::ifstream trace_file(path);
+    std::stringstream file_content;
+    file_content << trace_file.rdbuf();
+    REQUIRE(count_occurrences(file_content.str(), "\"ph\":\"X\"") == 2 * 9 * n_tiles);
+
+    REQUIRE_THROWS_AS(executor.write_trace("/nonexistent/trace.json"), std::runtime_error);
+}
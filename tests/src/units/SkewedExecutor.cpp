@@ -0,0 +1,144 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/SkewedExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <cstring>
+#include <res/IDBuffer.hpp>
+#include <res/TransFuncs.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+using TransFunc = FPGATransFunc<stencil_radius>;
+using SkewedExecutorImpl =
+    SkewedExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>;
+using StencilExecutorImpl =
+    StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>;
+
+template <typename Executor>
+void test_skewed_executor_run(uindex_t grid_width, uindex_t grid_height, uindex_t n_generations) {
+    Executor executor(Cell::halo(), TransFunc());
+    executor.set_input(make_id_buffer<Cell>(grid_width, grid_height));
+    REQUIRE(executor.get_grid_range().c == grid_width);
+    REQUIRE(executor.get_grid_range().r == grid_height);
+
+    // A second run to show that behavior is still correct when i_generation != 0:
+    for (uindex_t i_run = 1; i_run <= 2; i_run++) {
+        executor.run(n_generations);
+        REQUIRE(executor.get_i_generation() == i_run * n_generations);
+
+        buffer<Cell, 2> out_buffer(range<2>(grid_width, grid_height));
+        executor.copy_output(out_buffer);
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                REQUIRE(out_buffer_ac[c][r].c == c);
+                REQUIRE(out_buffer_ac[c][r].r == r);
+                REQUIRE(out_buffer_ac[c][r].i_generation == i_run * n_generations);
+                REQUIRE(out_buffer_ac[c][r].status == CellStatus::Normal);
+            }
+        }
+    }
+}
+
+TEST_CASE("SkewedExecutor::run", "[SkewedExecutor]") {
+    uindex_t n_generations = 2 * pipeline_length + 1;
+
+    test_skewed_executor_run<SkewedExecutorImpl>(grid_width, grid_height, n_generations);
+    // Grids that are smaller than a tile or not a multiple of the tile range:
+    test_skewed_executor_run<SkewedExecutorImpl>(tile_width / 2, 3, n_generations);
+    test_skewed_executor_run<SkewedExecutorImpl>(grid_width + 7, grid_height - 5, n_generations);
+}
+
+TEST_CASE("SkewedExecutor::run with different pipeline lengths", "[SkewedExecutor]") {
+    using SinglePipelineExecutor =
+        SkewedExecutor<Cell, stencil_radius, TransFunc, 1, tile_width, tile_height>;
+    using LongPipelineExecutor =
+        SkewedExecutor<Cell, stencil_radius, TransFunc, 7, tile_width, tile_height>;
+
+    test_skewed_executor_run<SinglePipelineExecutor>(grid_width, grid_height - 1, 3);
+    test_skewed_executor_run<LongPipelineExecutor>(grid_width + 1, grid_height, 10);
+}
+
+TEST_CASE("SkewedExecutor is bit-identical to StencilExecutor", "[SkewedExecutor]") {
+    uindex_t width = grid_width - tile_width / 2 + 3;
+    uindex_t height = grid_height - tile_height / 2 + 5;
+    uindex_t n_generations = 3 * pipeline_length - 1;
+
+    SkewedExecutorImpl skewed_executor(Cell::halo(), TransFunc());
+    skewed_executor.set_input(make_id_buffer<Cell>(width, height));
+    skewed_executor.set_i_generation(7);
+    skewed_executor.run(n_generations);
+
+    StencilExecutorImpl stencil_executor(Cell::halo(), TransFunc());
+    stencil_executor.set_input(make_id_buffer<Cell>(width, height));
+    stencil_executor.set_i_generation(7);
+    stencil_executor.run(n_generations);
+
+    buffer<Cell, 2> skewed_buffer(range<2>(width, height));
+    skewed_executor.copy_output(skewed_buffer);
+    buffer<Cell, 2> stencil_buffer(range<2>(width, height));
+    stencil_executor.copy_output(stencil_buffer);
+
+    auto skewed_ac = skewed_buffer.get_access<access::mode::read>();
+    auto stencil_ac = stencil_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            REQUIRE(memcmp(&skewed_ac[c][r], &stencil_ac[c][r], sizeof(Cell)) == 0);
+        }
+    }
+}
+
+uint64_t n_counted_updates = 0;
+
+class CountingTransFunc {
+  public:
+    Cell operator()(Stencil<Cell, stencil_radius> const &stencil) const {
+        n_counted_updates++;
+        return stencil[ID(0, 0)];
+    }
+};
+
+TEST_CASE("SkewedExecutor matches its performance model", "[SkewedExecutor]") {
+    using CountingExecutor = SkewedExecutor<Cell, stencil_radius, CountingTransFunc,
+                                            pipeline_length, tile_width, tile_height>;
+    using CountingStencilExecutor = StencilExecutor<Cell, stencil_radius, CountingTransFunc,
+                                                    pipeline_length, tile_width, tile_height>;
+    uindex_t width = 3 * tile_width + 1;
+    uindex_t height = 2 * tile_height - 1;
+
+    CountingExecutor executor(Cell::halo(), CountingTransFunc());
+    executor.set_input(make_id_buffer<Cell>(width, height));
+    n_counted_updates = 0;
+    executor.run(pipeline_length);
+    REQUIRE(n_counted_updates ==
+            CountingExecutor::PerformanceModel::predict_pass(width, height)
+                .n_computed_cell_updates);
+    uint64_t n_skewed_updates = n_counted_updates;
+
+    CountingStencilExecutor stencil_executor(Cell::halo(), CountingTransFunc());
+    stencil_executor.set_input(make_id_buffer<Cell>(width, height));
+    n_counted_updates = 0;
+    stencil_executor.run(pipeline_length);
+    REQUIRE(n_skewed_updates < n_counted_updates);
+}
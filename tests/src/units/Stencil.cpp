@@ -17,11 +17,14 @@
  * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <StencilStream/MonotileExecutor.hpp>
 #include <StencilStream/Stencil.hpp>
+#include <StencilStream/StencilExecutor.hpp>
 #include <res/catch.hpp>
 #include <res/constants.hpp>
 
 using namespace stencil;
+using namespace cl::sycl;
 
 TEST_CASE("Stencil::diameter", "[Stencil]") {
     Stencil<index_t, 2> stencil(ID(0, 0), 0, 0, UID(42, 42));
@@ -60,4 +63,105 @@ TEST_CASE("Stencil::operator[](UID)", "[Stencil]") {
             REQUIRE(stencil[ID(c, r)] == index_t(c) + index_t(r) + 2 * stencil_radius);
         }
     }
-};
\ No newline at end of file
+};
+TEST_CASE("Stencil::get", "[Stencil]") {
+    Stencil<index_t, 2> stencil(ID(0, 0), 0, 0, UID(42, 42));
+
+    for (index_t c = -stencil_radius; c <= index_t(stencil_radius); c++) {
+        for (index_t r = -stencil_radius; r <= index_t(stencil_radius); r++) {
+            stencil[ID(c, r)] = 10 * c + r;
+        }
+    }
+
+    REQUIRE(stencil.get<0, 0>() == 0);
+    REQUIRE(stencil.get<-2, 1>() == -19);
+    REQUIRE(stencil.get<1, -2>() == 8);
+
+    stencil.get<2, 2>() = 42;
+    REQUIRE(stencil[ID(2, 2)] == 42);
+};
+
+/*
+ * A transition function that only reads a cross of cells. The `declare_access_set` parameter
+ * controls whether this is declared.
+ */
+template <bool declare_access_set> struct CrossTransFunc {
+    float operator()(Stencil<float, 2> const &stencil) const {
+        return 0.5 * stencil.get<0, 0>() + 0.1 * stencil.get<0, -1>() +
+               0.1 * stencil.get<0, 2>() + 0.1 * stencil.get<-2, 0>() + 0.1 * stencil.get<1, 0>() +
+               0.01 * stencil.generation;
+    }
+};
+
+template <> struct CrossTransFunc<true> : public CrossTransFunc<false> {
+    static constexpr bool accesses(index_t c, index_t r) { return c == 0 || r == 0; }
+};
+
+TEST_CASE("StencilAccessSet", "[Stencil]") {
+    using DefaultSet = StencilAccessSet<CrossTransFunc<false>, 2>;
+    using CrossSet = StencilAccessSet<CrossTransFunc<true>, 2>;
+
+    static_assert(!has_access_set<CrossTransFunc<false>>::value);
+    static_assert(has_access_set<CrossTransFunc<true>>::value);
+
+    for (uindex_t c = 0; c < 5; c++) {
+        for (uindex_t r = 0; r < 5; r++) {
+            REQUIRE(DefaultSet::is_read(c, r));
+            REQUIRE(DefaultSet::is_stored(c, r));
+            REQUIRE(CrossSet::is_read(c, r) == (c == 2 || r == 2));
+            // Cells have to be stored if a cell north of them is read.
+            REQUIRE(CrossSet::is_stored(c, r) == (c == 2 || r >= 2));
+        }
+    }
+}
+
+template <typename Executor, typename ReferenceExecutor> void test_access_set_executor() {
+    uindex_t width = 50;
+    uindex_t height = 40;
+    uindex_t n_generations = 5;
+
+    buffer<float, 2> in_buffer(range<2>(width, height));
+    {
+        auto in_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t r = 0; r < height; r++) {
+                in_ac[c][r] = float((c * 7 + r * 13) % 17);
+            }
+        }
+    }
+
+    Executor executor(1.0, CrossTransFunc<true>());
+    executor.set_input(in_buffer);
+    executor.run(n_generations);
+
+    ReferenceExecutor reference_executor(1.0, CrossTransFunc<false>());
+    reference_executor.set_input(in_buffer);
+    reference_executor.run(n_generations);
+
+    buffer<float, 2> out_buffer(range<2>(width, height));
+    executor.copy_output(out_buffer);
+    buffer<float, 2> reference_buffer(range<2>(width, height));
+    reference_executor.copy_output(reference_buffer);
+
+    auto out_ac = out_buffer.get_access<access::mode::read>();
+    auto reference_ac = reference_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            REQUIRE(out_ac[c][r] == reference_ac[c][r]);
+        }
+    }
+}
+
+TEST_CASE("StencilExecutor with a StencilAccessSet", "[Stencil]") {
+    test_access_set_executor<
+        StencilExecutor<float, 2, CrossTransFunc<true>, pipeline_length, tile_width, tile_height>,
+        StencilExecutor<float, 2, CrossTransFunc<false>, pipeline_length, tile_width,
+                        tile_height>>();
+}
+
+TEST_CASE("MonotileExecutor with a StencilAccessSet", "[Stencil]") {
+    test_access_set_executor<
+        MonotileExecutor<float, 2, CrossTransFunc<true>, pipeline_length, tile_width, tile_height>,
+        MonotileExecutor<float, 2, CrossTransFunc<false>, pipeline_length, tile_width,
+                         tile_height>>();
+}
@@ -18,8 +18,11 @@
  * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
+#include <StencilStream/AutoExecutor.hpp>
 #include <StencilStream/MonotileExecutor.hpp>
 #include <StencilStream/StencilExecutor.hpp>
+#include <StencilStream/tiling/OutOfCoreGrid.hpp>
+#include <res/IDBuffer.hpp>
 #include <res/TransFuncs.hpp>
 #include <res/catch.hpp>
 #include <res/constants.hpp>
@@ -32,6 +35,8 @@ using TransFunc = FPGATransFunc<stencil_radius>;
 using SingleQueueExecutorImpl = SingleQueueExecutor<Cell, stencil_radius, TransFunc>;
 using StencilExecutorImpl = StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length>;
 using MonotileExecutorImpl = MonotileExecutor<Cell, stencil_radius, TransFunc, pipeline_length>;
+using AutoExecutorImpl =
+    AutoExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>;
 
 void test_executor_set_input_copy_output(SingleQueueExecutorImpl *executor, uindex_t grid_width,
                                          uindex_t grid_height) {
@@ -135,4 +140,488 @@ TEST_CASE("StencilExecutor::run", "[StencilExecutor]") {
 TEST_CASE("MonotileExecutor::run", "[MonotileExecutor]") {
     MonotileExecutorImpl executor(Cell::halo(), TransFunc());
     test_executor_run(&executor, grid_width, grid_height);
-}
\ No newline at end of file
+}
+
+TEST_CASE("AutoExecutor::run", "[AutoExecutor]") {
+    AutoExecutorImpl monotile_executor(Cell::halo(), TransFunc());
+    test_executor_run(&monotile_executor, tile_width, tile_height - 1);
+    REQUIRE(monotile_executor.is_monotile_active());
+
+    AutoExecutorImpl tiling_executor(Cell::halo(), TransFunc());
+    test_executor_run(&tiling_executor, grid_width, grid_height);
+    REQUIRE(!tiling_executor.is_monotile_active());
+}
+
+TEST_CASE("AutoExecutor::set_input", "[AutoExecutor]") {
+    uindex_t n_generations = pipeline_length + 1;
+    AutoExecutorImpl executor(Cell::halo(), TransFunc());
+
+    buffer<Cell, 2> small_buffer(range<2>(tile_width, tile_height));
+    {
+        auto small_buffer_ac = small_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < tile_width; c++) {
+            for (uindex_t r = 0; r < tile_height; r++) {
+                small_buffer_ac[c][r] = Cell{index_t(c), index_t(r), 0, CellStatus::Normal};
+            }
+        }
+    }
+    executor.set_input(small_buffer);
+    REQUIRE(executor.is_monotile_active());
+    executor.run(n_generations);
+    executor.copy_output(small_buffer);
+
+    // Grow the grid. The new cells are initialized with the current generation index.
+    buffer<Cell, 2> big_buffer(range<2>(grid_width, grid_height));
+    {
+        auto small_buffer_ac = small_buffer.get_access<access::mode::read>();
+        auto big_buffer_ac = big_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                if (c < tile_width && r < tile_height) {
+                    big_buffer_ac[c][r] = small_buffer_ac[c][r];
+                } else {
+                    big_buffer_ac[c][r] =
+                        Cell{index_t(c), index_t(r), index_t(n_generations), CellStatus::Normal};
+                }
+            }
+        }
+    }
+    executor.set_input(big_buffer);
+    REQUIRE(!executor.is_monotile_active());
+    REQUIRE(executor.get_grid_range().c == grid_width);
+    REQUIRE(executor.get_grid_range().r == grid_height);
+    REQUIRE(executor.get_i_generation() == n_generations);
+    executor.run(n_generations);
+    REQUIRE(executor.get_i_generation() == 2 * n_generations);
+
+    executor.copy_output(big_buffer);
+    {
+        auto big_buffer_ac = big_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                REQUIRE(big_buffer_ac[c][r].c == c);
+                REQUIRE(big_buffer_ac[c][r].r == r);
+                REQUIRE(big_buffer_ac[c][r].i_generation == 2 * n_generations);
+                REQUIRE(big_buffer_ac[c][r].status == CellStatus::Normal);
+            }
+        }
+    }
+}
+
+class AddTransFunc {
+  public:
+    AddTransFunc(uint8_t delta) : delta(delta) {}
+
+    uint8_t operator()(Stencil<uint8_t, 1> const &stencil) const {
+        return stencil[ID(0, 0)] + delta;
+    }
+
+  private:
+    uint8_t delta;
+};
+
+template <typename Executor> void test_executor_copy_output_region() {
+    uindex_t grid_width = 70;
+    uindex_t grid_height = 50;
+
+    buffer<uint8_t, 2> in_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                in_buffer_ac[c][r] = c + 2 * r;
+            }
+        }
+    }
+
+    Executor executor(0, AddTransFunc(0));
+    executor.set_input(in_buffer);
+
+    UID region_offset(10, 5);
+    UID region_range(41, 40);
+    UID stride(4, 3);
+    buffer<uint8_t, 2> out_buffer(range<2>(11, 14));
+    executor.copy_output(out_buffer, region_offset, region_range, stride);
+    {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < 11; c++) {
+            for (uindex_t r = 0; r < 14; r++) {
+                uindex_t grid_c = region_offset.c + c * stride.c;
+                uindex_t grid_r = region_offset.r + r * stride.r;
+                REQUIRE(out_buffer_ac[c][r] == uint8_t(grid_c + 2 * grid_r));
+            }
+        }
+    }
+
+    REQUIRE_THROWS_AS(executor.copy_output(out_buffer, region_offset, region_range, UID(1, 1)),
+                      std::range_error);
+    REQUIRE_THROWS_AS(executor.copy_output(out_buffer, region_offset, UID(61, 40), stride),
+                      std::out_of_range);
+    REQUIRE_THROWS_AS(executor.copy_output(out_buffer, region_offset, region_range, UID(0, 3)),
+                      std::invalid_argument);
+}
+
+template <typename Executor>
+void test_executor_run_ensemble(uindex_t grid_width, uindex_t grid_height) {
+    uindex_t n_generations = 5;
+
+    buffer<uint8_t, 2> in_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                in_buffer_ac[c][r] = 0;
+            }
+        }
+    }
+
+    Executor executor(0, AddTransFunc(0));
+    executor.set_input(in_buffer);
+
+    std::vector<AddTransFunc> trans_funcs{AddTransFunc(1), AddTransFunc(2), AddTransFunc(3)};
+    std::vector<buffer<uint8_t, 2>> out_buffers =
+        executor.run_ensemble(trans_funcs, n_generations);
+    REQUIRE(out_buffers.size() == trans_funcs.size());
+    REQUIRE(executor.get_i_generation() == 0);
+
+    for (uindex_t i_member = 0; i_member < out_buffers.size(); i_member++) {
+        REQUIRE(out_buffers[i_member].get_range()[0] == grid_width);
+        REQUIRE(out_buffers[i_member].get_range()[1] == grid_height);
+
+        auto out_buffer_ac = out_buffers[i_member].template get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                REQUIRE(out_buffer_ac[c][r] == (i_member + 1) * n_generations);
+            }
+        }
+    }
+
+    buffer<uint8_t, 2> out_buffer(range<2>(grid_width, grid_height));
+    executor.copy_output(out_buffer);
+    auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < grid_width; c++) {
+        for (uindex_t r = 0; r < grid_height; r++) {
+            REQUIRE(out_buffer_ac[c][r] == 0);
+        }
+    }
+}
+
+TEST_CASE("StencilExecutor::run_ensemble", "[StencilExecutor]") {
+    test_executor_run_ensemble<StencilExecutor<uint8_t, 1, AddTransFunc, 2, 32, 32>>(48, 40);
+}
+
+TEST_CASE("MonotileExecutor::run_ensemble", "[MonotileExecutor]") {
+    test_executor_run_ensemble<MonotileExecutor<uint8_t, 1, AddTransFunc, 2, 32, 32>>(30, 20);
+}
+
+TEST_CASE("StencilExecutor::copy_output(cl::sycl::buffer<T, 2>, UID, UID, UID)",
+          "[StencilExecutor]") {
+    test_executor_copy_output_region<StencilExecutor<uint8_t, 1, AddTransFunc, 2, 32, 32>>();
+    test_executor_copy_output_region<
+        StencilExecutor<uint8_t, 1, AddTransFunc, 2, 32, 32, 1024, tiling::OutOfCoreGrid>>();
+}
+
+TEST_CASE("MonotileExecutor::copy_output(cl::sycl::buffer<T, 2>, UID, UID, UID)",
+          "[MonotileExecutor]") {
+    test_executor_copy_output_region<MonotileExecutor<uint8_t, 1, AddTransFunc, 2, 128, 64>>();
+}
+
+TEST_CASE("StencilExecutor::run (OutOfCoreGrid)", "[StencilExecutor]") {
+    using OutOfCoreExecutorImpl = StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length,
+                                                  1024, 1024, 1024, tiling::OutOfCoreGrid>;
+    OutOfCoreExecutorImpl executor(Cell::halo(), TransFunc());
+    test_executor_run(&executor, grid_width, grid_height);
+}
+
+class SubTransFunc {
+  public:
+    uint8_t operator()(Stencil<uint8_t, 1> const &stencil) const {
+        return stencil[ID(0, 0)] - 1;
+    }
+};
+
+template <typename Executor>
+void test_executor_checkpoint(uindex_t grid_width, uindex_t grid_height) {
+    string path = "/tmp/stencil_executor_checkpoint.grid";
+    string async_path = "/tmp/stencil_executor_checkpoint_async.grid";
+
+    buffer<uint8_t, 2> in_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                in_buffer_ac[c][r] = c + r;
+            }
+        }
+    }
+
+    Executor executor(0, AddTransFunc(1));
+    executor.set_input(in_buffer);
+    executor.run(3);
+    executor.save_checkpoint(path);
+    std::future<void> async_checkpoint = executor.save_checkpoint_async(async_path);
+    executor.run(2);
+    async_checkpoint.get();
+
+    auto check_checkpoint = [&](string const &checkpoint_path) {
+        Executor restored_executor(0, AddTransFunc(1));
+        restored_executor.load_checkpoint(checkpoint_path);
+        REQUIRE(restored_executor.get_i_generation() == 3);
+        REQUIRE(restored_executor.get_grid_range().c == grid_width);
+        REQUIRE(restored_executor.get_grid_range().r == grid_height);
+
+        restored_executor.run(2);
+        REQUIRE(restored_executor.get_i_generation() == 5);
+
+        buffer<uint8_t, 2> out_buffer(range<2>(grid_width, grid_height));
+        restored_executor.copy_output(out_buffer);
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                REQUIRE(out_buffer_ac[c][r] == uint8_t(c + r + 5));
+            }
+        }
+    };
+    check_checkpoint(path);
+    check_checkpoint(async_path);
+
+    using OtherExecutor = StencilExecutor<uint8_t, 1, SubTransFunc, 2, 32, 32>;
+    REQUIRE(OtherExecutor::get_config_hash() != Executor::get_config_hash());
+    OtherExecutor other_executor(0, SubTransFunc());
+    REQUIRE_THROWS_AS(other_executor.load_checkpoint(path), std::runtime_error);
+
+    remove(path.c_str());
+    remove(async_path.c_str());
+}
+
+TEST_CASE("StencilExecutor::load_checkpoint", "[StencilExecutor]") {
+    test_executor_checkpoint<StencilExecutor<uint8_t, 1, AddTransFunc, 2, 32, 32>>(48, 40);
+}
+
+TEST_CASE("StencilExecutor::load_checkpoint (OutOfCoreGrid)", "[StencilExecutor]") {
+    test_executor_checkpoint<
+        StencilExecutor<uint8_t, 1, AddTransFunc, 2, 32, 32, 1024, tiling::OutOfCoreGrid>>(48, 40);
+}
+
+class MaxTransFunc {
+  public:
+    uint8_t operator()(Stencil<uint8_t, 1> const &stencil) const {
+        uint8_t max = 0;
+        for (index_t c = -1; c <= 1; c++) {
+            for (index_t r = -1; r <= 1; r++) {
+                max = std::max(max, stencil[ID(c, r)]);
+            }
+        }
+        return max;
+    }
+};
+
+template <typename Executor> void test_executor_activity_tracking() {
+    uindex_t grid_width = 150;
+    uindex_t grid_height = 100;
+    uindex_t n_generations = 11;
+
+    buffer<uint8_t, 2> in_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                in_buffer_ac[c][r] = (c == 5 && r == 7) ? 1 : 0;
+            }
+        }
+    }
+
+    Executor executor(0, MaxTransFunc());
+    REQUIRE(!executor.is_activity_tracking_enabled());
+    executor.set_activity_tracking(true);
+    REQUIRE(executor.is_activity_tracking_enabled());
+    executor.set_input(in_buffer);
+    executor.run(n_generations);
+    REQUIRE(executor.get_i_generation() == n_generations);
+    REQUIRE(executor.get_n_skipped_tiles() > 0);
+
+    buffer<uint8_t, 2> out_buffer(range<2>(grid_width, grid_height));
+    executor.copy_output(out_buffer);
+    auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < grid_width; c++) {
+        for (uindex_t r = 0; r < grid_height; r++) {
+            bool reached = std::max(index_t(c) - 5, 5 - index_t(c)) <= index_t(n_generations) &&
+                           std::max(index_t(r) - 7, 7 - index_t(r)) <= index_t(n_generations);
+            REQUIRE(out_buffer_ac[c][r] == (reached ? 1 : 0));
+        }
+    }
+}
+
+TEST_CASE("StencilExecutor::set_activity_tracking", "[StencilExecutor]") {
+    test_executor_activity_tracking<StencilExecutor<uint8_t, 1, MaxTransFunc, 2, 32, 32>>();
+    test_executor_activity_tracking<
+        StencilExecutor<uint8_t, 1, MaxTransFunc, 2, 32, 32, 1024, tiling::OutOfCoreGrid>>();
+}
+
+TEST_CASE("StencilExecutor::set_tile_order", "[StencilExecutor]") {
+    uindex_t width = 2 * grid_width + 3;
+    uindex_t height = grid_height + 5;
+    uindex_t n_generations = pipeline_length + 1;
+    UID tile_range(width / tile_width + 1, height / tile_height + 1);
+
+    buffer<Cell, 2> in_buffer = make_id_buffer<Cell>(width, height);
+
+    for (TileOrder order :
+         {TileOrder::COLUMN_MAJOR, TileOrder::ROW_MAJOR, TileOrder::Z_ORDER, TileOrder::SNAKE}) {
+        StencilExecutor<Cell, stencil_radius, TransFunc, pipeline_length, tile_width, tile_height>
+            executor(Cell::halo(), TransFunc());
+        REQUIRE(executor.get_tile_order() == TileOrder::COLUMN_MAJOR);
+        executor.set_tile_order(order);
+        REQUIRE(executor.get_tile_order() == order);
+        executor.select_emulator(true);
+        executor.set_input(in_buffer);
+        executor.run(n_generations);
+
+        buffer<Cell, 2> out_buffer(range<2>(width, height));
+        executor.copy_output(out_buffer);
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t r = 0; r < height; r++) {
+                REQUIRE(out_buffer_ac[c][r].c == c);
+                REQUIRE(out_buffer_ac[c][r].r == r);
+                REQUIRE(out_buffer_ac[c][r].i_generation == n_generations);
+                REQUIRE(out_buffer_ac[c][r].status == CellStatus::Normal);
+            }
+        }
+
+        // The execution kernels are recorded in the order of their submission.
+        std::vector<UID> schedule = get_tile_schedule(order, tile_range);
+        std::vector<UID> submitted_tiles;
+        for (RuntimeSample::KernelRecord record :
+             executor.get_runtime_sample().get_kernel_records()) {
+            if (record.category == RuntimeSample::KernelCategory::EXECUTION && record.i_pass == 0) {
+                submitted_tiles.push_back(record.tile_id);
+            }
+        }
+        REQUIRE(submitted_tiles == schedule);
+    }
+}
+
+TEST_CASE("StencilExecutor::set_domain_mask", "[StencilExecutor]") {
+    uindex_t grid_width = 96;
+    uindex_t grid_height = 64;
+    uindex_t n_generations = 5;
+
+    buffer<uint8_t, 2> in_buffer(range<2>(grid_width, grid_height));
+    buffer<bool, 2> mask_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        auto mask_buffer_ac = mask_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                in_buffer_ac[c][r] = 0;
+                // Only a single cell in the tile (0, 0) and the tile (2, 1) are inside the domain.
+                mask_buffer_ac[c][r] = (c == 31 && r == 31) || (c == 70 && r == 40);
+            }
+        }
+    }
+
+    StencilExecutor<uint8_t, 1, AddTransFunc, 2, 32, 32> executor(0, AddTransFunc(1));
+    executor.set_input(in_buffer);
+    executor.set_domain_mask(mask_buffer);
+    REQUIRE(executor.is_tile_in_domain(UID(0, 0)));
+    REQUIRE(!executor.is_tile_in_domain(UID(1, 0)));
+    REQUIRE(executor.is_tile_in_domain(UID(2, 1)));
+    executor.run(n_generations);
+
+    buffer<uint8_t, 2> out_buffer(range<2>(grid_width, grid_height));
+    executor.copy_output(out_buffer);
+    {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                bool in_domain = (c < 32 && r < 32) || (c >= 64 && r >= 32);
+                REQUIRE(out_buffer_ac[c][r] == (in_domain ? n_generations : 0));
+            }
+        }
+    }
+
+    executor.clear_domain_mask();
+    REQUIRE(executor.is_tile_in_domain(UID(1, 0)));
+
+    executor.set_domain_mask(buffer<bool, 2>(range<2>(grid_width, grid_height + 1)));
+    REQUIRE_THROWS_AS(executor.run(1), std::range_error);
+}
+
+class HalveTransFunc {
+  public:
+    float operator()(Stencil<float, 1> const &stencil) const { return 0.5f * stencil[ID(0, 0)]; }
+};
+
+template <typename Executor>
+void test_executor_run_until(uindex_t grid_width, uindex_t grid_height) {
+    constexpr uindex_t executor_pipeline_length = 2;
+    // The cell with the largest changes is in the south-eastern corner of the grid.
+    auto initial_value = [&](uindex_t c, uindex_t r) {
+        return (c == grid_width - 1 && r == grid_height - 1) ? 4.0f : 1.0f;
+    };
+
+    buffer<float, 2> in_buffer(range<2>(grid_width, grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < grid_width; c++) {
+            for (uindex_t r = 0; r < grid_height; r++) {
+                in_buffer_ac[c][r] = initial_value(c, r);
+            }
+        }
+    }
+
+    // The transition function only reads the central cell, so the halo value only affects the
+    // cells of partial tiles that are outside of the grid, which must not be reduced.
+    Executor executor(100.0f, HalveTransFunc());
+    executor.set_input(in_buffer);
+
+    // The reduction compares the last two generations of a pass. Every generation halves the
+    // cells, so the maximal change is half of the maximal cell value before the last generation,
+    // which is 4 * 2^(-i_generation) after the pass.
+    float max_delta = executor.run_until(
+        MaxAbsDifference<float>(), [](float delta) { return delta < 1e-2f; }, 100);
+    REQUIRE(executor.get_i_generation() == 5 * executor_pipeline_length);
+    REQUIRE(max_delta == 4.0f / 1024.0f);
+
+    max_delta = executor.run_until(
+        MaxAbsDifference<float>(), [](float delta) { return delta < 1e-3f; }, 100);
+    REQUIRE(executor.get_i_generation() == 6 * executor_pipeline_length);
+    REQUIRE(max_delta == 4.0f / 4096.0f);
+
+    // The maximal number of generations is respected, even if it is not a multiple of the
+    // pipeline length. The last pass only computes one generation, which is compared with the
+    // generation before it.
+    max_delta = executor.run_until(
+        MaxAbsDifference<float>(), [](float) { return false; }, 3);
+    REQUIRE(executor.get_i_generation() == 6 * executor_pipeline_length + 3);
+    REQUIRE(max_delta == 4.0f / 32768.0f);
+
+    REQUIRE(executor.run_until(MaxAbsDifference<float>(), [](float) { return true; }, 0) == 0.0f);
+    REQUIRE(executor.get_i_generation() == 6 * executor_pipeline_length + 3);
+
+    buffer<float, 2> out_buffer(range<2>(grid_width, grid_height));
+    executor.copy_output(out_buffer);
+    auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < grid_width; c++) {
+        for (uindex_t r = 0; r < grid_height; r++) {
+            REQUIRE(out_buffer_ac[c][r] == initial_value(c, r) / 32768.0f);
+        }
+    }
+}
+
+TEST_CASE("StencilExecutor::run_until", "[StencilExecutor]") {
+    test_executor_run_until<StencilExecutor<float, 1, HalveTransFunc, 2, 32, 32>>(50, 40);
+    test_executor_run_until<
+        StencilExecutor<float, 1, HalveTransFunc, 2, 32, 32, 1024, tiling::OutOfCoreGrid>>(50,
+                                                                                            40);
+}
+
+TEST_CASE("MonotileExecutor::run_until", "[MonotileExecutor]") {
+    test_executor_run_until<MonotileExecutor<float, 1, HalveTransFunc, 2, 64, 64>>(50, 40);
+}
+
+TEST_CASE("AutoExecutor::run_until", "[AutoExecutor]") {
+    test_executor_run_until<AutoExecutor<float, 1, HalveTransFunc, 2, 32, 32>>(50, 40);
+    test_executor_run_until<AutoExecutor<float, 1, HalveTransFunc, 2, 32, 32>>(20, 30);
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/TileOrder.hpp>
+#include <res/catch.hpp>
+#include <set>
+#include <utility>
+
+using namespace std;
+using namespace stencil;
+
+void require_complete_schedule(vector<UID> const &schedule, UID tile_range) {
+    REQUIRE(schedule.size() == tile_range.c * tile_range.r);
+    set<pair<uindex_t, uindex_t>> tiles;
+    for (UID tile_id : schedule) {
+        REQUIRE(tile_id.c < tile_range.c);
+        REQUIRE(tile_id.r < tile_range.r);
+        tiles.insert(make_pair(tile_id.c, tile_id.r));
+    }
+    REQUIRE(tiles.size() == schedule.size());
+}
+
+TEST_CASE("get_tile_schedule", "[TileOrder]") {
+    for (TileOrder order :
+         {TileOrder::COLUMN_MAJOR, TileOrder::ROW_MAJOR, TileOrder::Z_ORDER, TileOrder::SNAKE}) {
+        require_complete_schedule(get_tile_schedule(order, UID(5, 3)), UID(5, 3));
+        require_complete_schedule(get_tile_schedule(order, UID(1, 7)), UID(1, 7));
+        require_complete_schedule(get_tile_schedule(order, UID(8, 8)), UID(8, 8));
+        REQUIRE(get_tile_schedule(order, UID(0, 4)).empty());
+    }
+
+    vector<UID> schedule = get_tile_schedule(TileOrder::COLUMN_MAJOR, UID(2, 3));
+    REQUIRE(schedule[1] == UID(0, 1));
+    REQUIRE(schedule[3] == UID(1, 0));
+
+    schedule = get_tile_schedule(TileOrder::ROW_MAJOR, UID(2, 3));
+    REQUIRE(schedule[1] == UID(1, 0));
+    REQUIRE(schedule[3] == UID(1, 1));
+
+    schedule = get_tile_schedule(TileOrder::SNAKE, UID(3, 3));
+    vector<UID> snake = {UID(0, 0), UID(0, 1), UID(0, 2), UID(1, 2), UID(1, 1),
+                         UID(1, 0), UID(2, 0), UID(2, 1), UID(2, 2)};
+    REQUIRE(schedule == snake);
+
+    schedule = get_tile_schedule(TileOrder::Z_ORDER, UID(4, 4));
+    vector<UID> z_order_start = {UID(0, 0), UID(0, 1), UID(1, 0), UID(1, 1),
+                                 UID(0, 2), UID(0, 3), UID(1, 2), UID(1, 3)};
+    REQUIRE(vector<UID>(schedule.begin(), schedule.begin() + 8) == z_order_start);
+    REQUIRE(schedule[8] == UID(2, 0));
+    REQUIRE(schedule.back() == UID(3, 3));
+
+    // Tiles outside of the range are skipped, but the order of the others is kept.
+    schedule = get_tile_schedule(TileOrder::Z_ORDER, UID(3, 2));
+    vector<UID> partial_z_order = {UID(0, 0), UID(0, 1), UID(1, 0),
+                                   UID(1, 1), UID(2, 0), UID(2, 1)};
+    REQUIRE(schedule == partial_z_order);
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/MonotileExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <StencilStream/TransFuncSequence.hpp>
+#include <StencilStream/UniformTable.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+struct AddFunc {
+    float summand = 1.0;
+
+    float operator()(Stencil<float, 1> const &stencil) const {
+        return stencil[ID(0, 0)] + summand;
+    }
+};
+
+struct DoubleFunc {
+    static constexpr bool accesses(index_t c, index_t r) { return c == 0 && r == 0; }
+
+    float operator()(Stencil<float, 1> const &stencil) const { return 2.0 * stencil[ID(0, 0)]; }
+};
+
+using Sequence = TransFuncSequence<AddFunc, DoubleFunc>;
+
+TEST_CASE("TransFuncSequence::operator()", "[TransFuncSequence]") {
+    Sequence sequence(AddFunc{3.0}, DoubleFunc());
+    REQUIRE(sequence.get<0>().summand == 3.0);
+
+    for (uindex_t stage = 0; stage < 4; stage++) {
+        // The function is selected by the pipeline stage, which is a constant of the stage.
+        Stencil<float, 1> stencil(ID(0, 0), 0, stage, UID(1, 1));
+        stencil[ID(0, 0)] = 5.0;
+
+        REQUIRE(Sequence::get_function_index(stage) == stage % 2);
+        if (stage % 2 == 0) {
+            REQUIRE(sequence(stencil) == 8.0);
+        } else {
+            REQUIRE(sequence(stencil) == 10.0);
+        }
+    }
+
+    static_assert(Sequence::n_functions == 2);
+    static_assert(stage_period<Sequence>::value == 2);
+    static_assert(stage_period<AddFunc>::value == 1);
+
+    // AddFunc doesn't declare an access set and may therefore read every cell.
+    static_assert(Sequence::accesses(1, -1));
+    static_assert(TransFuncSequence<DoubleFunc, DoubleFunc>::accesses(0, 0));
+    static_assert(!TransFuncSequence<DoubleFunc, DoubleFunc>::accesses(1, -1));
+}
+
+struct ScaleFunc {
+    struct Uniform {
+        float factor;
+    };
+
+    Uniform get_uniform(uindex_t i_generation) const { return Uniform{float(i_generation)}; }
+
+    float operator()(Stencil<float, 1> const &stencil, Uniform const &uniform) const {
+        return uniform.factor * stencil[ID(0, 0)];
+    }
+};
+
+TEST_CASE("TransFuncSequence with uniforms", "[TransFuncSequence]") {
+    using UniformSequence = TransFuncSequence<AddFunc, ScaleFunc>;
+    UniformSequence sequence;
+    static_assert(has_uniform<UniformSequence>::value);
+
+    UniformTable<UniformSequence, 4> uniforms(sequence, 4, 8);
+    for (uindex_t stage = 0; stage < 4; stage++) {
+        Stencil<float, 1> stencil(ID(0, 0), 4 + stage, stage, UID(1, 1));
+        stencil[ID(0, 0)] = 2.0;
+
+        if (stage % 2 == 0) {
+            REQUIRE(uniforms.apply(sequence, stencil) == 3.0);
+        } else {
+            // The uniform is computed for the generation index of the stage.
+            REQUIRE(uniforms.apply(sequence, stencil) == 2.0 * float(4 + stage));
+        }
+    }
+}
+
+template <typename Executor> void test_sequence_executor() {
+    uindex_t width = 16;
+    uindex_t height = 8;
+
+    buffer<float, 2> in_buffer(range<2>(width, height));
+    {
+        auto in_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t r = 0; r < height; r++) {
+                in_ac[c][r] = 0.0;
+            }
+        }
+    }
+
+    Executor executor(0.0, Sequence());
+    executor.set_input(in_buffer);
+
+    // One complete pass.
+    executor.run(2);
+
+    buffer<float, 2> out_buffer(range<2>(width, height));
+    executor.copy_output(out_buffer);
+    {
+        auto out_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t r = 0; r < height; r++) {
+                REQUIRE(out_ac[c][r] == (0.0 + 1.0) * 2.0);
+            }
+        }
+    }
+
+    // One complete pass and one pass that only computes the first stage.
+    executor.run(3);
+
+    executor.copy_output(out_buffer);
+    {
+        auto out_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t r = 0; r < height; r++) {
+                REQUIRE(out_ac[c][r] == (((0.0 + 1.0) * 2.0 + 1.0) * 2.0) + 1.0);
+            }
+        }
+    }
+
+    // The next pass would start with stage 0 at an odd generation index and would therefore apply
+    // the functions out of order.
+    REQUIRE(executor.get_i_generation() == 5);
+    REQUIRE_THROWS_AS(executor.run(1), std::invalid_argument);
+}
+
+TEST_CASE("StencilExecutor with TransFuncSequence", "[TransFuncSequence]") {
+    test_sequence_executor<StencilExecutor<float, 1, Sequence, 2, tile_width, tile_height>>();
+}
+
+TEST_CASE("MonotileExecutor with TransFuncSequence", "[TransFuncSequence]") {
+    test_sequence_executor<MonotileExecutor<float, 1, Sequence, 2, tile_width, tile_height>>();
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <StencilStream/MonotileExecutor.hpp>
+#include <StencilStream/StencilExecutor.hpp>
+#include <StencilStream/UniformTable.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace std;
+using namespace stencil;
+using namespace cl::sycl;
+
+/*
+ * Adds the square of the generation index to the cell. The square is computed on the host and
+ * counted, so that the tests can verify that it is only computed once per stage and pass.
+ */
+struct SquareSumFunc {
+    struct Uniform {
+        float square;
+    };
+
+    uindex_t *n_uniform_calls;
+
+    Uniform get_uniform(uindex_t i_generation) const {
+        (*n_uniform_calls)++;
+        return Uniform{float(i_generation * i_generation)};
+    }
+
+    float operator()(Stencil<float, 1> const &stencil, Uniform const &uniform) const {
+        return stencil[ID(0, 0)] + uniform.square;
+    }
+};
+
+struct PlainFunc {
+    float operator()(Stencil<float, 1> const &stencil) const { return stencil[ID(0, 0)]; }
+};
+
+static_assert(has_uniform<SquareSumFunc>::value);
+static_assert(!has_uniform<PlainFunc>::value);
+
+TEST_CASE("UniformTable", "[UniformTable]") {
+    uindex_t n_uniform_calls = 0;
+    SquareSumFunc trans_func{&n_uniform_calls};
+
+    // Only the first three of four stages compute a generation.
+    UniformTable<SquareSumFunc, 4> table(trans_func, 5, 8);
+    REQUIRE(n_uniform_calls == 3);
+    REQUIRE(table[0].square == 25.0);
+    REQUIRE(table[1].square == 36.0);
+    REQUIRE(table[2].square == 49.0);
+    REQUIRE(table[3].square == 0.0);
+
+    Stencil<float, 1> stencil(ID(0, 0), 6, 1, UID(1, 1));
+    stencil[ID(0, 0)] = 1.0;
+    REQUIRE(table.apply(trans_func, stencil) == 37.0);
+
+    static_assert(UniformTable<SquareSumFunc, 4>::is_applicable<float, 1>);
+    static_assert(UniformTable<PlainFunc, 4>::is_applicable<float, 1>);
+    static_assert(!UniformTable<PlainFunc, 4>::is_applicable<float, 2>);
+}
+
+template <typename Executor> void test_uniform_executor() {
+    uindex_t width = 16;
+    uindex_t height = 8;
+    uindex_t n_generations = 5;
+
+    buffer<float, 2> in_buffer(range<2>(width, height));
+    {
+        auto in_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < width; c++) {
+            for (uindex_t r = 0; r < height; r++) {
+                in_ac[c][r] = 0.0;
+            }
+        }
+    }
+
+    uindex_t n_uniform_calls = 0;
+    Executor executor(0.0, SquareSumFunc{&n_uniform_calls});
+    executor.set_input(in_buffer);
+    executor.run(n_generations);
+
+    // One call per computed generation and kernel invocation, but none per cell.
+    REQUIRE(n_uniform_calls % n_generations == 0);
+    REQUIRE(n_uniform_calls < width * height);
+
+    buffer<float, 2> out_buffer(range<2>(width, height));
+    executor.copy_output(out_buffer);
+    auto out_ac = out_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            REQUIRE(out_ac[c][r] == 0.0 + 1.0 + 4.0 + 9.0 + 16.0);
+        }
+    }
+}
+
+TEST_CASE("StencilExecutor with uniforms", "[UniformTable]") {
+    test_uniform_executor<StencilExecutor<float, 1, SquareSumFunc, 2, tile_width, tile_height>>();
+}
+
+TEST_CASE("MonotileExecutor with uniforms", "[UniformTable]") {
+    test_uniform_executor<MonotileExecutor<float, 1, SquareSumFunc, 2, tile_width, tile_height>>();
+}
@@ -73,6 +73,43 @@ TEST_CASE("Grid::Grid(cl::sycl::buffer<T, 2>, T)", "[Grid]") {
     }
 }
 
+TEST_CASE("Grid::copy_to(cl::sycl::queue, cl::sycl::buffer<T, 2>&, UID, UID)", "[Grid]") {
+    buffer<ID, 2> in_buffer(range<2>(add_grid_width, add_grid_height));
+    {
+        auto in_buffer_ac = in_buffer.get_access<access::mode::discard_write>();
+        for (uindex_t c = 0; c < add_grid_width; c++) {
+            for (uindex_t r = 0; r < add_grid_height; r++) {
+                in_buffer_ac[c][r] = ID(c, r);
+            }
+        }
+    }
+    TestGrid grid(in_buffer);
+    queue working_queue;
+
+    UID region_offset(3, 1);
+    UID stride(5, 3);
+    range<2> out_range((add_grid_width - region_offset.c + stride.c - 1) / stride.c,
+                       (add_grid_height - region_offset.r + stride.r - 1) / stride.r);
+    buffer<ID, 2> out_buffer(out_range);
+    grid.copy_to(working_queue, out_buffer, region_offset, stride);
+
+    {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < out_range[0]; c++) {
+            for (uindex_t r = 0; r < out_range[1]; r++) {
+                REQUIRE(out_buffer_ac[c][r].c == region_offset.c + c * stride.c);
+                REQUIRE(out_buffer_ac[c][r].r == region_offset.r + r * stride.r);
+            }
+        }
+    }
+
+    buffer<ID, 2> too_big_buffer(range<2>(out_range[0] + 1, out_range[1]));
+    REQUIRE_THROWS_AS(grid.copy_to(working_queue, too_big_buffer, region_offset, stride),
+                      std::out_of_range);
+    REQUIRE_THROWS_AS(grid.copy_to(working_queue, out_buffer, region_offset, UID(0, 1)),
+                      std::invalid_argument);
+}
+
 TEST_CASE("Grid::submit_tile_input", "[Grid]") {
     using grid_in_pipe = pipe<class grid_in_pipe_id, ID>;
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <CL/sycl.hpp>
+#include <CL/sycl/INTEL/fpga_extensions.hpp>
+#include <StencilStream/tiling/GridFile.hpp>
+#include <cstdio>
+#include <res/IDBuffer.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace stencil;
+using namespace stencil::tiling;
+using namespace cl::sycl;
+using namespace std;
+
+using TestGridFile = GridFile<ID, tile_width, tile_height, halo_radius, burst_length>;
+using TestGrid = TestGridFile::GridImpl;
+using TestOutOfCoreGrid = TestGridFile::OutOfCoreGridImpl;
+
+const uindex_t file_grid_width = 2 * tile_width + 1;
+const uindex_t file_grid_height = tile_height + 1;
+
+template <typename G> void check_file_grid(G &grid) {
+    REQUIRE(grid.get_grid_range().c == file_grid_width);
+    REQUIRE(grid.get_grid_range().r == file_grid_height);
+
+    buffer<ID, 2> out_buffer(range<2>(file_grid_width, file_grid_height));
+    grid.copy_to(out_buffer);
+
+    auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < file_grid_width; c++) {
+        for (uindex_t r = 0; r < file_grid_height; r++) {
+            REQUIRE(out_buffer_ac[c][r].c == c);
+            REQUIRE(out_buffer_ac[c][r].r == r);
+        }
+    }
+}
+
+TEST_CASE("GridFile::write(std::string, GridImpl&)", "[GridFile]") {
+    string path = "/tmp/stencil_grid_file_test.grid";
+    TestGrid grid(make_id_buffer<ID>(file_grid_width, file_grid_height));
+    TestGridFile::write(path, grid);
+
+    TestGridFile::Header header = TestGridFile::read_header(path);
+    REQUIRE(header.grid_width == file_grid_width);
+    REQUIRE(header.grid_height == file_grid_height);
+
+    TestGrid read_grid = TestGridFile::read_grid(path);
+    check_file_grid(read_grid);
+
+    TestOutOfCoreGrid mapped_grid = TestGridFile::map_grid(path);
+    check_file_grid(mapped_grid);
+
+    remove(path.c_str());
+}
+
+TEST_CASE("GridFile::write(std::string, OutOfCoreGridImpl&)", "[GridFile]") {
+    string path = "/tmp/stencil_grid_file_test_ooc.grid";
+    TestOutOfCoreGrid grid(make_id_buffer<ID>(file_grid_width, file_grid_height));
+    TestGridFile::write(path, grid);
+
+    TestOutOfCoreGrid mapped_grid = TestGridFile::map_grid(path);
+    check_file_grid(mapped_grid);
+
+    // The file is mapped privately and must not be altered.
+    mapped_grid.get_tile_cells(UID(0, 0))[0] = ID(42, 42);
+    TestGrid read_grid = TestGridFile::read_grid(path);
+    check_file_grid(read_grid);
+
+    remove(path.c_str());
+}
+
+TEST_CASE("GridFile::write(std::string, cl::sycl::buffer<T, 2>)", "[GridFile]") {
+    string path = "/tmp/stencil_grid_file_test_buffer.grid";
+    TestGridFile::write(path, make_id_buffer<ID>(file_grid_width, file_grid_height));
+
+    TestGrid read_grid = TestGridFile::read_grid(path);
+    check_file_grid(read_grid);
+
+    remove(path.c_str());
+}
+
+TEST_CASE("GridFile::read_header", "[GridFile]") {
+    string path = "/tmp/stencil_grid_file_test_invalid.grid";
+    REQUIRE_THROWS_AS(TestGridFile::read_header(path), std::runtime_error);
+
+    TestGridFile::write(path, make_id_buffer<ID>(file_grid_width, file_grid_height));
+    using OtherGridFile = GridFile<ID, tile_width, tile_height, halo_radius + 1, burst_length>;
+    REQUIRE_THROWS_AS(OtherGridFile::read_header(path), std::runtime_error);
+    REQUIRE_THROWS_AS(OtherGridFile::map_grid(path), std::runtime_error);
+
+    FILE *file = fopen(path.c_str(), "r+");
+    fputs("NOTAGRID", file);
+    fclose(file);
+    REQUIRE_THROWS_AS(TestGridFile::read_header(path), std::runtime_error);
+
+    remove(path.c_str());
+}
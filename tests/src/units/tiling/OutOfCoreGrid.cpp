@@ -0,0 +1,215 @@
+/*
+ * Copyright © 2020-2021 Jan-Oliver Opdenhövel, Paderborn Center for Parallel Computing, Paderborn
+ * University
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ * associated documentation files (the “Software”), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ * sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or
+ * substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ * NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <CL/sycl.hpp>
+#include <CL/sycl/INTEL/fpga_extensions.hpp>
+#include <StencilStream/tiling/OutOfCoreGrid.hpp>
+#include <res/IDBuffer.hpp>
+#include <res/catch.hpp>
+#include <res/constants.hpp>
+
+using namespace stencil;
+using namespace stencil::tiling;
+using namespace cl::sycl;
+using namespace std;
+
+using TestGrid = OutOfCoreGrid<ID, tile_width, tile_height, halo_radius, burst_length>;
+
+void test_out_of_core_grid_copy(TestGrid grid) {
+    uindex_t width = grid.get_grid_range().c;
+    uindex_t height = grid.get_grid_range().r;
+
+    REQUIRE(grid.get_tile_range().c == (width + tile_width - 1) / tile_width);
+    REQUIRE(grid.get_tile_range().r == (height + tile_height - 1) / tile_height);
+
+    buffer<ID, 2> out_buffer(range<2>(width, height));
+    grid.copy_to(out_buffer);
+
+    auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+    for (uindex_t c = 0; c < width; c++) {
+        for (uindex_t r = 0; r < height; r++) {
+            REQUIRE(out_buffer_ac[c][r].c == c);
+            REQUIRE(out_buffer_ac[c][r].r == r);
+        }
+    }
+}
+
+TEST_CASE("OutOfCoreGrid::OutOfCoreGrid(cl::sycl::buffer<T, 2>)", "[OutOfCoreGrid]") {
+    test_out_of_core_grid_copy(TestGrid(make_id_buffer<ID>(grid_width + 1, grid_height + 1)));
+}
+
+TEST_CASE("OutOfCoreGrid::copy_to(cl::sycl::queue, cl::sycl::buffer<T, 2>&, UID, UID)",
+          "[OutOfCoreGrid]") {
+    TestGrid grid(make_id_buffer<ID>(grid_width + 1, grid_height + 1));
+    queue working_queue;
+
+    UID region_offset(2, 3);
+    UID stride(3, 4);
+    range<2> out_range(grid_width / stride.c, grid_height / stride.r);
+    buffer<ID, 2> out_buffer(out_range);
+    grid.copy_to(working_queue, out_buffer, region_offset, stride);
+
+    {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+        for (uindex_t c = 0; c < out_range[0]; c++) {
+            for (uindex_t r = 0; r < out_range[1]; r++) {
+                REQUIRE(out_buffer_ac[c][r].c == region_offset.c + c * stride.c);
+                REQUIRE(out_buffer_ac[c][r].r == region_offset.r + r * stride.r);
+            }
+        }
+    }
+
+    buffer<ID, 2> too_big_buffer(range<2>(out_range[0] + 2, out_range[1]));
+    REQUIRE_THROWS_AS(grid.copy_to(working_queue, too_big_buffer, region_offset, stride),
+                      std::out_of_range);
+}
+
+TEST_CASE("OutOfCoreGrid::get_tile_cells", "[OutOfCoreGrid]") {
+    TestGrid grid(make_id_buffer<ID>(2 * tile_width, 2 * tile_height));
+
+    ID *tile = grid.get_tile_cells(UID(1, 0));
+    ID *core = tile + TestGrid::get_part_cell_offset(TestGrid::Part::CORE);
+    REQUIRE(core[0].c == tile_width + halo_radius);
+    REQUIRE(core[0].r == halo_radius);
+    REQUIRE(core[1].c == tile_width + halo_radius);
+    REQUIRE(core[1].r == halo_radius + 1);
+    REQUIRE(core[core_height].c == tile_width + halo_radius + 1);
+    REQUIRE(core[core_height].r == halo_radius);
+
+    REQUIRE_THROWS_AS(grid.get_tile_cells(UID(2, 0)), std::out_of_range);
+}
+
+TEST_CASE("OutOfCoreGrid::submit_tile_input", "[OutOfCoreGrid]") {
+    using grid_in_pipe = cl::sycl::pipe<class out_of_core_grid_in_pipe_id, ID>;
+
+    buffer<ID, 2> out_buffer(range<2>(2 * halo_radius + tile_width, 2 * halo_radius + tile_height));
+
+#ifdef HARDWARE
+    INTEL::fpga_selector device_selector;
+#else
+    INTEL::fpga_emulator_selector device_selector;
+#endif
+    cl::sycl::queue working_queue(device_selector);
+
+    TestGrid grid(make_id_buffer<ID>(3 * tile_width, 3 * tile_height));
+    grid.submit_tile_input<grid_in_pipe>(working_queue, UID(1, 1));
+
+    working_queue.submit([&](handler &cgh) {
+        auto out_buffer_ac = out_buffer.get_access<access::mode::discard_write>(cgh);
+
+        cgh.single_task<class out_of_core_input_test_kernel>([=]() {
+            for (uindex_t c = 0; c < 2 * halo_radius + tile_width; c++) {
+                for (uindex_t r = 0; r < 2 * halo_radius + tile_height; r++) {
+                    out_buffer_ac[c][r] = grid_in_pipe::read();
+                }
+            }
+        });
+    });
+
+    auto out_buffer_ac = out_buffer.get_access<access::mode::read>();
+
+    for (uindex_t c = 0; c < 2 * halo_radius + tile_width; c++) {
+        for (uindex_t r = 0; r < 2 * halo_radius + tile_height; r++) {
+            REQUIRE(out_buffer_ac[c][r].c == c + tile_width - halo_radius);
+            REQUIRE(out_buffer_ac[c][r].r == r + tile_height - halo_radius);
+        }
+    }
+}
+
+TEST_CASE("OutOfCoreGrid::submit_tile_output", "[OutOfCoreGrid]") {
+    using grid_out_pipe = cl::sycl::pipe<class out_of_core_grid_out_pipe_id, ID>;
+
+#ifdef HARDWARE
+    INTEL::fpga_selector device_selector;
+#else
+    INTEL::fpga_emulator_selector device_selector;
+#endif
+    cl::sycl::queue working_queue(device_selector);
+
+    TestGrid grid(2 * tile_width, tile_height, std::nullopt, 1);
+
+    for (uindex_t tile_c = 0; tile_c < 2; tile_c++) {
+        working_queue.submit([&](handler &cgh) {
+            cgh.single_task<class out_of_core_output_test_kernel>([=]() {
+                for (uindex_t c = 0; c < tile_width; c++) {
+                    for (uindex_t r = 0; r < tile_height; r++) {
+                        grid_out_pipe::write(ID(tile_c * tile_width + c, r));
+                    }
+                }
+            });
+        });
+
+        grid.submit_tile_output<grid_out_pipe>(working_queue, UID(tile_c, 0));
+    }
+
+    test_out_of_core_grid_copy(grid);
+}
+
+TEST_CASE("OutOfCoreGrid::take_tile", "[OutOfCoreGrid]") {
+    using grid_out_pipe = cl::sycl::pipe<class out_of_core_take_tile_pipe_id, ID>;
+    cl::sycl::queue working_queue;
+
+    // The outputs of the source stay pending, since the window is large enough for both tiles.
+    TestGrid source(2 * tile_width, tile_height, std::nullopt, 4);
+    for (uindex_t tile_c = 0; tile_c < 2; tile_c++) {
+        working_queue.submit([&](handler &cgh) {
+            cgh.single_task<class out_of_core_take_tile_kernel>([=]() {
+                for (uindex_t c = 0; c < tile_width; c++) {
+                    for (uindex_t r = 0; r < tile_height; r++) {
+                        grid_out_pipe::write(ID(tile_c * tile_width + c, r));
+                    }
+                }
+            });
+        });
+        source.submit_tile_output<grid_out_pipe>(working_queue, UID(tile_c, 0));
+    }
+
+    // Taking a tile writes the pending outputs back first.
+    TestGrid grid = source.make_output_grid();
+    grid.take_tile(source, UID(0, 0));
+    grid.take_tile(source, UID(1, 0));
+    test_out_of_core_grid_copy(grid);
+
+    // Reading the source as an input does not create pending outputs, so the tiles can be taken
+    // while the input kernels are in flight.
+    using grid_in_pipe = cl::sycl::pipe<class out_of_core_take_tile_in_pipe_id, ID>;
+    source.submit_tile_input<grid_in_pipe>(working_queue, UID(0, 0));
+    TestGrid other_grid = source.make_output_grid();
+    other_grid.take_tile(source, UID(0, 0));
+    other_grid.take_tile(source, UID(1, 0));
+    test_out_of_core_grid_copy(other_grid);
+    for (uindex_t i = 0; i < (2 * halo_radius + tile_width) * (2 * halo_radius + tile_height);
+         i++) {
+        grid_in_pipe::read();
+    }
+}
+
+TEST_CASE("OutOfCoreGrid (swap file)", "[OutOfCoreGrid]") {
+    TestGrid grid(grid_width, grid_height, "/tmp");
+
+    TestGrid output_grid = grid.make_output_grid();
+    REQUIRE(output_grid.get_grid_range().c == grid_width);
+    REQUIRE(output_grid.get_grid_range().r == grid_height);
+
+    ID *tile = output_grid.get_tile_cells(UID(0, 0));
+    tile[0] = ID(42, 42);
+    REQUIRE(tile[0].c == 42);
+
+    REQUIRE_THROWS_AS(TestGrid(grid_width, grid_height, "/does/not/exist"), std::runtime_error);
+}